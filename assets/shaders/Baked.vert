@@ -0,0 +1,38 @@
+#version 330 core
+
+// Per-vertex attributes of a static chunk (see BakedVertex), baked in world
+// space by Renderer::BakeChunk
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 inTexCoord;   // Scaled, the tile repeats
+layout(location = 3) in vec4 inColor;      // a = bloomed
+layout(location = 4) in int inTileIndex;   // -1 for untextured meshes
+layout(location = 5) in int inLayer;       // Of uTextureArray
+
+uniform mat4 uViewProjection;
+
+// Same outputs as Base.vert, for Mesh.frag
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+flat out float fragTexIndex;
+out vec3 fragColor;
+flat out float fragTileIndex;
+flat out float fragLayer;
+flat out float fragBloomed;
+out vec3 fragWorldPos;
+
+void main()
+{
+    fragWorldPos = inPosition;
+    gl_Position = uViewProjection * vec4(inPosition, 1.0);
+
+    fragNormal = inNormal;
+    fragTexCoord = inTexCoord;
+
+    // The face's texture index is already in the tile index
+    fragTexIndex = 0.0;
+    fragColor = inColor.rgb;
+    fragTileIndex = float(inTileIndex);
+    fragLayer = float(inLayer);
+    fragBloomed = inColor.a;
+}
@@ -1,4 +1,3 @@
-
 #version 330 core
 
 // Per-vertex attributes
@@ -7,36 +6,51 @@ layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 layout(location = 3) in float inTexIndex;
 
-// Per-instance attributes (mat4 takes 4 locations)
-layout(location = 4) in mat4 inInstanceModel;      // Locations 4, 5, 6, 7
-layout(location = 8) in mat4 inInstanceNormal;     // Locations 8, 9, 10, 11
-layout(location = 12) in vec3 inInstanceColor;     // Location 12
-layout(location = 13) in float inInstanceTileIndex; // Location 13
+// Per-instance attributes (see MeshInstance)
+layout(location = 4) in vec3 inInstancePosition;
+layout(location = 5) in vec3 inInstanceScale;
+layout(location = 6) in vec4 inInstanceRotation;  // Quaternion
+layout(location = 7) in vec4 inInstanceColor;     // a = bloomed
+layout(location = 8) in int inInstanceTileIndex;
+layout(location = 9) in int inInstanceLayer;     // Of uTextureArray
 
 uniform mat4 uViewProjection;
+uniform mat4 uNormalMatrix;
 
 out vec3 fragNormal;
 out vec2 fragTexCoord;
 flat out float fragTexIndex;
 out vec3 fragColor;
 flat out float fragTileIndex;
+flat out float fragLayer;
+flat out float fragBloomed;
 out vec2 spriteSize;
 out vec3 fragWorldPos;
 
+// Rotates v by the unit quaternion q
+vec3 Rotate(vec4 q, vec3 v)
+{
+    return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
 void main()
 {
-    // Transform position to world space
-    vec4 worldPos = inInstanceModel * vec4(inPosition, 1.0);
-    fragWorldPos = worldPos.xyz;
+    // Snorm rotations are only nearly unit length
+    vec4 rotation = normalize(inInstanceRotation);
+
+    // Transform position to world space (scale, rotate, translate)
+    vec3 worldPos = Rotate(rotation, inPosition * inInstanceScale) +
+                    inInstancePosition;
+    fragWorldPos = worldPos;
     
     // Transform position by view-projection
-    gl_Position = uViewProjection * worldPos;
+    gl_Position = uViewProjection * vec4(worldPos, 1.0);
     
-    // Transform normal to world space using instance normal matrix
-    fragNormal = mat3(inInstanceNormal) * inNormal;
+    // Transform normal to world space
+    fragNormal = mat3(uNormalMatrix) * Rotate(rotation, inNormal);
     
-    // Extract scale from model matrix
-    vec3 scale = vec3(length(inInstanceModel[0].xyz), length(inInstanceModel[1].xyz), length(inInstanceModel[2].xyz));
+    // Scale is signed for flipped sprites
+    vec3 scale = abs(inInstanceScale);
     spriteSize = scale.xy;
     // Scale texture coordinates based on the face normal direction
     vec3 aN = abs(inNormal);
@@ -50,6 +64,8 @@ void main()
     fragTexIndex = inTexIndex;
     
     // Pass instance color and tile index
-    fragColor = inInstanceColor;
-    fragTileIndex = inInstanceTileIndex;
+    fragColor = inInstanceColor.rgb;
+    fragTileIndex = float(inInstanceTileIndex);
+    fragLayer = float(inInstanceLayer);
+    fragBloomed = inInstanceColor.a;
 }
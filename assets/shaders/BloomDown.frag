@@ -0,0 +1,22 @@
+#version 330 core
+
+in vec2 fragTexCoord;
+
+uniform sampler2D uTexture;     // Previous (twice as large) level
+
+out vec4 outColor;
+
+// Dual filter downsample: the center and four diagonal bilinear taps one
+// source texel away, so each tap averages a 2x2 block
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(uTexture, 0));
+
+    vec3 result = texture(uTexture, fragTexCoord).rgb * 4.0;
+    result += texture(uTexture, fragTexCoord + vec2(-texel.x, -texel.y)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2( texel.x, -texel.y)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2(-texel.x,  texel.y)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2( texel.x,  texel.y)).rgb;
+
+    outColor = vec4(result / 8.0, 1.0);
+}
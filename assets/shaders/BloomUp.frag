@@ -0,0 +1,25 @@
+#version 330 core
+
+in vec2 fragTexCoord;
+
+uniform sampler2D uTexture;     // Next (half as large) level
+
+out vec4 outColor;
+
+// Dual filter upsample: a tent of eight bilinear taps, the four edge taps two
+// source texels away and the four diagonal ones (weighted twice) one away
+void main()
+{
+    vec2 texel = 1.0 / vec2(textureSize(uTexture, 0));
+
+    vec3 result = texture(uTexture, fragTexCoord + vec2(-2.0 * texel.x, 0.0)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2(2.0 * texel.x, 0.0)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2(0.0, -2.0 * texel.y)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2(0.0, 2.0 * texel.y)).rgb;
+    result += texture(uTexture, fragTexCoord + vec2(-texel.x, -texel.y)).rgb * 2.0;
+    result += texture(uTexture, fragTexCoord + vec2( texel.x, -texel.y)).rgb * 2.0;
+    result += texture(uTexture, fragTexCoord + vec2(-texel.x,  texel.y)).rgb * 2.0;
+    result += texture(uTexture, fragTexCoord + vec2( texel.x,  texel.y)).rgb * 2.0;
+
+    outColor = vec4(result / 12.0, 1.0);
+}
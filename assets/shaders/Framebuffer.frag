@@ -6,6 +6,10 @@ uniform sampler2D uFramebufferTexture;
 uniform sampler2D uBloomTexture;
 uniform bool uIsDark;
 
+// The blur chain keeps the bloom's brightness, this restores the glow of the
+// old ten-pass blur (which brightened it about four times)
+const float bloomIntensity = 4.0;
+
 out vec4 outColor;
 
 void main()
@@ -13,8 +17,8 @@ void main()
     // Sample the main framebuffer texture
     vec3 sceneColor = texture(uFramebufferTexture, fragTexCoord).rgb;
     
-    // Sample the bloom texture (already blurred)
-    vec3 bloomColor = texture(uBloomTexture, fragTexCoord).rgb;
+    // Sample the bloom texture (already blurred, unless no object is bloomed)
+    vec3 bloomColor = texture(uBloomTexture, fragTexCoord).rgb * bloomIntensity;
     
     // Additive blending of bloom
     vec3 result;
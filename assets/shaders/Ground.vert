@@ -0,0 +1,63 @@
+#version 330 core
+
+// A corner of a ground cell's quad (see GroundVertex)
+layout(location = 0) in ivec4 inCorner;    // xy = column, row; zw = corner
+
+uniform mat4 uViewProjection;
+
+// Per cell: tile index (-1 for a flat color) and GroundKind
+uniform isampler2D uGroundCells;
+
+// Per GroundKind, must match GroundKind::Count. Colors: a = bloomed.
+// Animations: frames, seconds per frame, lifted
+uniform vec4 uGroundColors[5];
+uniform vec4 uGroundAnimations[5];
+
+uniform int uGroundLayer;      // Of uTextureArray, the level's floor atlas
+uniform float uGroundLift;     // Added to the lifted kinds
+uniform float uTime;           // Seconds, steps the animated kinds
+uniform int uBloomed;          // Bloom state of the pass
+
+// Same outputs as Base.vert, for Mesh.frag
+out vec3 fragNormal;
+out vec2 fragTexCoord;
+flat out float fragTexIndex;
+out vec3 fragColor;
+flat out float fragTileIndex;
+flat out float fragLayer;
+flat out float fragBloomed;
+out vec3 fragWorldPos;
+
+void main()
+{
+    ivec4 cell = texelFetch(uGroundCells, inCorner.xy, 0);
+    vec4 color = uGroundColors[cell.y];
+    vec4 animation = uGroundAnimations[cell.y];
+
+    // Cells of the other pass collapse to a point outside the clip volume
+    if (cell.y == 0 || int(color.a) != uBloomed) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        return;
+    }
+
+    // Corners as in PlaneMesh, so tiles face the way they did on the planes
+    vec2 corner = vec2(inCorner.zw);
+    vec3 worldPos = vec3(float(inCorner.x) - 0.5 + corner.x,
+                         0.5 + animation.z * uGroundLift,
+                         -float(inCorner.y) + 0.5 - corner.y);
+    fragWorldPos = worldPos;
+    gl_Position = uViewProjection * vec4(worldPos, 1.0);
+
+    fragNormal = vec3(0.0, 1.0, 0.0);
+    fragTexCoord = corner;
+    fragTexIndex = 0.0;
+
+    int tileIndex = cell.x;
+    if (tileIndex >= 0 && animation.x > 1.0) {
+        tileIndex += int(mod(floor(uTime / animation.y), animation.x));
+    }
+    fragColor = color.rgb;
+    fragTileIndex = float(tileIndex);
+    fragLayer = float(uGroundLayer);
+    fragBloomed = color.a;
+}
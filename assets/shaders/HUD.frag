@@ -1,14 +1,14 @@
 #version 330 core
 
-// From vertex shader (Screenspace.vert provides these)
+// From vertex shader
 in vec2 fragTexCoord;
+in vec4 fragTint;           // Color tint/modulation, per instance
+flat in int fragTileIndex;  // Which tile to display from the atlas, per instance
 
 // HUD texture atlas uniforms
 uniform sampler2D uHUDTexture;
 uniform vec2 uAtlasTileSize;
 uniform int uAtlasColumns;
-uniform int uTileIndex;  // Which tile to display from the atlas
-uniform vec4 uTintColor; // Color tint/modulation (default white)
 
 uniform bool uHasTexture;
 
@@ -18,21 +18,21 @@ void main()
 {   
 
     if(!uHasTexture){
-        outColor = uTintColor;
+        outColor = fragTint;
         return;
     }
 
     // If tileIndex is negative, treat as a full texture sample (no atlas)
-    if (uTileIndex < 0)
+    if (fragTileIndex < 0)
     {
         vec4 texColor = texture(uHUDTexture, fragTexCoord);
-        outColor = texColor * uTintColor;
+        outColor = texColor * fragTint;
         return;
     }
 
     // Calculate tile position in the atlas
-    int tileX = uTileIndex % uAtlasColumns;
-    int tileY = uTileIndex / uAtlasColumns;
+    int tileX = fragTileIndex % uAtlasColumns;
+    int tileY = fragTileIndex / uAtlasColumns;
 
     // Calculate UV offset for the tile
     vec2 tileOffset = vec2(float(tileX), float(tileY)) * uAtlasTileSize;
@@ -55,5 +55,5 @@ void main()
     }
 
     // Apply tint color
-    outColor = texColor * uTintColor;
+    outColor = texColor * fragTint;
 }
@@ -4,18 +4,23 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
 layout(location = 2) in vec2 inTexCoord;
 
-// HUD positioning uniforms (in NDC space)
-uniform vec2 uNDCPosition;  // Center position in NDC (-1 to 1)
-uniform vec2 uNDCScale;     // Size in NDC space
+// Per-instance attributes (see HUDInstance), in NDC space
+layout(location = 4) in vec4 inInstanceRect;  // Center xy (-1 to 1), size zw
+layout(location = 5) in vec4 inInstanceTint;  // Color tint/modulation
+layout(location = 6) in int inInstanceTileIndex;
 
 out vec2 fragTexCoord;
+out vec4 fragTint;
+flat out int fragTileIndex;
 
 void main()
 {
     // Transform the sprite quad vertex to the HUD position and scale
     // inPosition is in range [-0.5, 0.5] (sprite quad is centered)
-    vec2 transformedPos = inPosition.xy * uNDCScale + uNDCPosition;
+    vec2 transformedPos = inPosition.xy * inInstanceRect.zw + inInstanceRect.xy;
     
     gl_Position = vec4(transformedPos, 0.0, 1.0);
     fragTexCoord = inTexCoord;
+    fragTint = inInstanceTint;
+    fragTileIndex = inInstanceTileIndex;
 }
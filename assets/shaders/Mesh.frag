@@ -5,24 +5,26 @@ in vec3 fragNormal;
 in vec2 fragTexCoord;
 flat in float fragTexIndex;         // Per vertex texturing
 in vec3 fragColor;                  // Per instance color
+flat in float fragBloomed;          // Per instance, 0 for bloom occluders
 flat in float fragTileIndex;        // Per instance tile index
+flat in float fragLayer;            // Per instance texture array layer
 in vec3 fragWorldPos;               // World position for fog
 
 uniform vec3 uDirectionalLightDir;          // Directional light direction
 uniform vec3 uDirectionalLightColor;    // Directional light color
 uniform vec3 uAmbientLightColor;        // Ambient light color
-uniform int uBloomPass;                 // 1 if rendering bloom pass, 0 otherwise
 uniform int uApplyLighting;             // 1 if lighting should be applied, 0 otherwise
 uniform vec3 uCameraPosition;           // Camera world position for fog
 uniform vec3 uFogColor;                 // Fog color
 uniform float uFogDensity;              // Fog density
 
-// Texture atlas uniforms
-uniform sampler2D uTextureAtlas;
-uniform vec2 uAtlasTileSize;
-uniform int uAtlasColumns;
+// Every atlas is a layer of the texture array. Per layer: tile size in UVs
+// (xy) and columns (z), see Renderer::UpdateTextureArray
+uniform sampler2DArray uTextureArray;
+uniform vec4 uLayerTiles[64];
 
-out vec4 outColor;
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec4 outBloom;    // Bloom target
 
 void main()
 {   
@@ -31,30 +33,34 @@ void main()
     {
         // Draw the object with the instance color only (opaque)
         outColor = vec4(fragColor, 1.0);
+        outBloom = vec4(fragBloomed < 0.5 ? vec3(0.0) : fragColor, 1.0);
         return;
     }
 
     // Calculate tile index from instance tile index and per-vertex texture index
     int tileIndex = int(fragTileIndex) + int(fragTexIndex);
+    vec4 layerTiles = uLayerTiles[int(fragLayer)];
+    vec2 tileSize = layerTiles.xy;
+    int columns = int(layerTiles.z);
 
     // Calculate tile position in the atlas
-    int tileX = tileIndex % uAtlasColumns;
-    int tileY = tileIndex / uAtlasColumns;
+    int tileX = tileIndex % columns;
+    int tileY = tileIndex / columns;
 
     // Calculate UV offset for the tile
-    vec2 tileOffset = vec2(float(tileX), float(tileY)) * uAtlasTileSize;
+    vec2 tileOffset = vec2(float(tileX), float(tileY)) * tileSize;
 
     // Use fractional part of texture coordinates for repeating within the tile
     vec2 repeatedTexCoord = fract(fragTexCoord);
 
     // Scale the repeated texture coordinates to fit within the tile
-    vec2 scaledTexCoord = repeatedTexCoord * uAtlasTileSize;
+    vec2 scaledTexCoord = repeatedTexCoord * tileSize;
 
     // Final UV coordinates in the atlas
     vec2 atlasUV = tileOffset + scaledTexCoord;
 
     // Sample from the texture atlas
-    vec4 texColor = texture(uTextureAtlas, atlasUV);
+    vec4 texColor = texture(uTextureArray, vec3(atlasUV, fragLayer));
 
     if(texColor.a < 0.1){
         discard;
@@ -62,6 +68,10 @@ void main()
 
 
     vec3 baseColor =  texColor.rgb * fragColor;
+
+    // Bloomed objects glow with their unlit color, the others render as black
+    // to provide occlusion
+    outBloom = vec4(fragBloomed < 0.5 ? vec3(0.0) : baseColor, texColor.a);
     
     // Flat shading: check if face is pointing toward light
     float lightIntensity = 0.5f + 0.5f* dot(normalize(fragNormal), -uDirectionalLightDir);
@@ -70,26 +80,15 @@ void main()
     vec3 lighting = uAmbientLightColor + (uDirectionalLightColor * lightIntensity);
 
     // Apply lighting to base color
-    if(uBloomPass != 1 && uApplyLighting == 1){ 
+    if(uApplyLighting == 1){ 
             baseColor *= lighting;
     }
 
-
-    // render as black to provide occlusion
-    if (uBloomPass == 1 && fragColor.r < 0.0 && baseColor.r < 0.7 && baseColor.g < 0.7 && baseColor.b < 0.7)
-    {
-        outColor = vec4(0.0,0.0,0.0, texColor.a);
-        return;
-    }
-    
-    // Apply exponential fog for non-bloomed objects
-    if (uBloomPass != 1)
-    {
-        float distance = length(fragWorldPos - uCameraPosition);
-        float fogFactor = exp(-distance * uFogDensity);
-        fogFactor = clamp(fogFactor, 0.0, 1.0);
-        baseColor = mix(uFogColor, baseColor, fogFactor);
-    }
+    // Apply exponential fog
+    float distance = length(fragWorldPos - uCameraPosition);
+    float fogFactor = exp(-distance * uFogDensity);
+    fogFactor = clamp(fogFactor, 0.0, 1.0);
+    baseColor = mix(uFogColor, baseColor, fogFactor);
     
     outColor = vec4(baseColor, texColor.a);
 }
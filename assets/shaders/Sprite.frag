@@ -1,71 +1,80 @@
 #version 330 core
 
 // From vertex shader
-in vec3 fragNormal;
 in vec2 fragTexCoord;
-flat in float fragTexIndex;         // Per vertex texturing
 in vec3 fragColor;                  // Per instance color
+flat in float fragBloomed;          // Per instance, 0 for bloom occluders
 flat in float fragTileIndex;        // Per instance tile index (used as direct tile index for sprites)
+flat in float fragLayer;            // Per instance texture array layer
 in vec2 spriteSize;
-in vec3 fragWorldPos;               // World position for fog
+in vec3 fragWorldPos;               // View position for fog
 
 
 uniform vec3 uDirectionalLightColor;    // Directional light color
 uniform vec3 uAmbientLightColor;        // Ambient light color
-uniform int uBloomPass;                 // 1 if rendering bloom pass, 0 otherwise
 uniform int uApplyLighting;             // 1 if lighting should be applied, 0 otherwise
 uniform vec3 uCameraPosition;           // Camera world position for fog
 uniform vec3 uFogColor;                 // Fog color
 uniform float uFogDensity;              // Fog density
 
-// Texture atlas uniforms
-uniform sampler2D uTextureAtlas;
-uniform vec2 uAtlasTileSize;
-uniform int uAtlasColumns;
+// Every atlas is a layer of the texture array. Per layer: tile size in UVs
+// (xy) and columns (z), see Renderer::UpdateTextureArray
+uniform sampler2DArray uTextureArray;
+uniform vec4 uLayerTiles[64];
+uniform int uUntextured;                // 1 for wireframe sprites
 
-out vec4 outColor;
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec4 outBloom;    // Bloom target
 
 void main()
 {   
 
     // If fragTileIndex is negative (e.g. -1) treat this as a uniformly colored sprite
-    if (fragTileIndex < 0.0)
+    if (fragTileIndex < 0.0 || uUntextured == 1)
     {
         outColor = vec4(fragColor, 1.0);
+        outBloom = vec4(fragBloomed < 0.5 ? vec3(0.0) : fragColor, 1.0);
         return;
     }
 
     // For sprites, use the instance tile index directly
     int tileIndex = int(fragTileIndex);
+    vec4 layerTiles = uLayerTiles[int(fragLayer)];
+    vec2 tileSize = layerTiles.xy;
+    int columns = int(layerTiles.z);
 
     // Calculate tile position in the atlas
-    int tileX = tileIndex % uAtlasColumns;
-    int tileY = tileIndex / uAtlasColumns;
+    int tileX = tileIndex % columns;
+    int tileY = tileIndex / columns;
 
     // Calculate UV offset for the tile
-    vec2 tileOffset = vec2(float(tileX), float(tileY)) * uAtlasTileSize;
+    vec2 tileOffset = vec2(float(tileX), float(tileY)) * tileSize;
 
     // Atlas texel size (in UV space)
-    vec2 atlasTexel = 1.0 / vec2(textureSize(uTextureAtlas, 0));
+    vec2 atlasTexel = 1.0 / vec2(textureSize(uTextureArray, 0).xy);
 
     // Compute inner tile UV size by removing a one-texel border on each side
-    vec2 innerTileSize = (uAtlasTileSize - 2.0 * atlasTexel) / spriteSize;
+    vec2 innerTileSize = (tileSize - 2.0 * atlasTexel) / spriteSize;
 
     // Final atlas UV: tileOffset + one-texel inset + scaled coordinate into the inner area
     vec2 atlasUV = tileOffset + atlasTexel + fragTexCoord * innerTileSize;
 
     // Sample from the texture atlas
-    vec4 texColor = texture(uTextureAtlas, atlasUV);
+    vec4 texColor = texture(uTextureArray, vec3(atlasUV, fragLayer));
 
     if(texColor.a < 0.1){
         discard;
     }
 
     vec3 baseColor = texColor.rgb * fragColor;
+
+    // Bloomed sprites glow with their unlit color, the others render as black
+    // to provide occlusion
+    outBloom = vec4(fragBloomed < 0.5 ? vec3(0.0) : baseColor, texColor.a);
     
     // Apply lighting to sprites (simple ambient + directional)
     // Sprites are billboards, so we use a simple lighting model
-    if (uApplyLighting == 1 && uBloomPass != 1) {
+    if (uApplyLighting == 1) {
         vec3 ambient = uAmbientLightColor * baseColor;
         vec3 diffuse = uDirectionalLightColor * baseColor * 0.5; // Reduced intensity for sprites
         vec3 litColor = ambient + diffuse;
@@ -78,13 +87,5 @@ void main()
         baseColor = mix(uFogColor, baseColor, fogFactor);
     }
     
-    // If rendering bloom pass and object is not bloomed (indicated by fragColor.r < 0)
-    // render as black to provide occlusion
-    if (uBloomPass == 1 && fragColor.r < 0.0)
-    {
-        outColor = vec4(0.0, 0.0, 0.0, texColor.a);
-        return;
-    }
-    
     outColor = vec4(baseColor, texColor.a);
 }
@@ -0,0 +1,48 @@
+#version 330 core
+
+// Per-vertex attributes (sprite quad)
+layout(location = 0) in vec3 inPosition;
+layout(location = 2) in vec2 inTexCoord;
+
+// Per-instance attributes (see SpriteInstance)
+layout(location = 4) in vec3 inInstancePosition;  // World
+layout(location = 5) in vec2 inInstanceSize;      // Signed for flipped sprites
+layout(location = 6) in float inInstanceRotation; // Around the view axis
+layout(location = 7) in vec4 inInstanceColor;     // a = bloomed
+layout(location = 8) in int inInstanceTileIndex;
+layout(location = 9) in int inInstanceLayer;       // Of uTextureArray
+
+uniform mat4 uView;
+uniform mat4 uProjection;
+
+out vec2 fragTexCoord;
+out vec3 fragColor;
+flat out float fragTileIndex;
+flat out float fragLayer;
+flat out float fragBloomed;
+out vec2 spriteSize;
+out vec3 fragWorldPos;
+
+void main()
+{
+    // Billboard: scale and rotate the quad in the screen plane, around the
+    // view position of the sprite
+    vec2 corner = inPosition.xy * inInstanceSize;
+    float c = cos(inInstanceRotation);
+    float s = sin(inInstanceRotation);
+    vec3 viewPos = (uView * vec4(inInstancePosition, 1.0)).xyz +
+                   vec3(c * corner.x - s * corner.y,
+                        s * corner.x + c * corner.y, 0.0);
+
+    // Fog in Sprite.frag uses the distance to the camera
+    fragWorldPos = viewPos;
+    gl_Position = uProjection * vec4(viewPos, 1.0);
+
+    spriteSize = abs(inInstanceSize);
+    fragTexCoord = inTexCoord * spriteSize;
+
+    fragColor = inInstanceColor.rgb;
+    fragTileIndex = float(inInstanceTileIndex);
+    fragLayer = float(inInstanceLayer);
+    fragBloomed = inInstanceColor.a;
+}
@@ -0,0 +1,56 @@
+// Mesh backend for the headless simulation benchmark: no vertex arrays or
+// instance buffers, only the bookkeeping exposed through Mesh's getters.
+
+#include "render/Mesh.hpp"
+#include <algorithm>
+
+Mesh::Mesh()
+    : mVertexArray(0), mVertexBuffer(0), mIndexBuffer(0), mNumVerts(0),
+      mNumIndices(0), mBoundsCenter(Vector3::Zero),
+      mBoundsExtents(Vector3::Zero) {}
+
+Mesh::~Mesh() {}
+
+void Mesh::Build(const MeshData meshdata) {
+  mTriangles = meshdata.triangles;
+  ComputeBounds(meshdata.vertices);
+  mNumVerts = static_cast<unsigned int>(meshdata.vertices.size());
+  mNumIndices = static_cast<unsigned int>(meshdata.triangles.size() * 3);
+}
+
+void Mesh::ComputeBounds(const std::vector<Vertex> &vertices) {
+  if (vertices.empty()) {
+    mBoundsCenter = Vector3::Zero;
+    mBoundsExtents = Vector3::Zero;
+    return;
+  }
+
+  Vector3 min = vertices[0].position;
+  Vector3 max = vertices[0].position;
+  for (const auto &vertex : vertices) {
+    min = Vector3(std::min(min.x, vertex.position.x),
+                  std::min(min.y, vertex.position.y),
+                  std::min(min.z, vertex.position.z));
+    max = Vector3(std::max(max.x, vertex.position.x),
+                  std::max(max.y, vertex.position.y),
+                  std::max(max.z, vertex.position.z));
+  }
+  mBoundsCenter = (min + max) * 0.5f;
+  mBoundsExtents = (max - min) * 0.5f;
+}
+
+bool Mesh::LoadFromFile(const std::string &) { return false; }
+
+void Mesh::SetActive() const {}
+
+void Mesh::SetActive(const InstanceRange &) const {}
+
+void Mesh::SetActiveSprites(const InstanceRange &) const {}
+
+void Mesh::SetActiveHUD(const InstanceRange &) const {}
+
+CubeMesh::CubeMesh() {}
+PlaneMesh::PlaneMesh() {}
+PyramidMesh::PyramidMesh() {}
+SphereMesh::SphereMesh() {}
+WallMesh::WallMesh() {}
@@ -0,0 +1,236 @@
+// Renderer backend for the headless simulation benchmark.
+// Keeps the asset caches that actor constructors rely on (meshes, atlases,
+// texture indices) and turns every GL/draw call into a no-op.
+
+#include "render/Renderer.hpp"
+#include "actors/Actor.hpp"
+#include "render/GlyphAtlas.hpp"
+#include "render/Mesh.hpp"
+#include "render/TextureAtlas.hpp"
+#include <algorithm>
+#include <iostream>
+
+Renderer::Renderer(Game *game)
+    : mGame(game), mViewMatrix(Matrix4::Identity),
+      mProjectionMatrix(Matrix4::Identity), mMeshShader(nullptr),
+      mBakedShader(nullptr), mGroundShader(nullptr), mSpriteShader(nullptr),
+      mFramebufferShader(nullptr), mHUDShader(nullptr),
+      mBloomDownShader(nullptr), mBloomUpShader(nullptr), mTextureArray(0),
+      mTextureArrayLayers(0), mSpriteQuad(nullptr), mScreenQuad(nullptr),
+      mInstanceStream(nullptr), mGPUTimer(nullptr), mFramebuffer(0),
+      mFramebufferTexture(0), mFramebufferDepthStencil(0),
+      mFramebufferWidth(480), mFramebufferHeight(270), mBloomTexture(0),
+      mBloomLevels(3), mHasBloom(false), mIsDark(true),
+      mLightDir(Vector3(1.0f, -1.0f, 0.5f)), mLightColor(Vector3::One),
+      mAmbientColor(Vector3::One), mBackgroundColor(Vector3::One),
+      mHUDCompositeRange{0, 0}, mHUDDraws(0), mHUDRedraws(0),
+      mInstanceUploadBytes(0), mStaticChunkCount(0), mStaticChunkDraws(0),
+      mGroundCellTexture(0), mGroundVertexArray(0), mGroundVertexBuffer(0),
+      mGroundIndexBuffer(0), mGroundLayer(0), mStateCalls(0),
+      mStateCallsSkipped(0) {}
+
+Renderer::~Renderer() {}
+
+bool Renderer::Initialize(float, float) { return true; }
+
+void Renderer::Shutdown() {
+  for (auto *texture : mTextures) {
+    if (texture) {
+      texture->Unload();
+    }
+  }
+  mTextureCache.clear();
+
+  for (auto &pair : mMeshCache) {
+    delete pair.second;
+  }
+  mMeshCache.clear();
+
+  for (auto &pair : mAtlasCache) {
+    delete pair.second;
+  }
+  mAtlasCache.clear();
+  for (auto &pair : mGlyphAtlasCache) {
+    delete pair.second;
+  }
+  mGlyphAtlasCache.clear();
+
+  for (auto *layer : mHUDLayers) {
+    DestroyHUDLayer(layer);
+  }
+  mHUDLayers.clear();
+}
+
+Texture *Renderer::LoadTexture(const std::string &fileName) {
+  auto it = mTextureCache.find(fileName);
+  if (it != mTextureCache.end()) {
+    return it->second;
+  }
+
+  Texture *texture = new Texture();
+  if (!texture->Load(fileName)) {
+    delete texture;
+    return nullptr;
+  }
+
+  mTextureCache[fileName] = texture;
+  mTextures.push_back(texture);
+  return texture;
+}
+
+int Renderer::RegisterTexture(Texture *texture) {
+  if (!texture) {
+    return -1;
+  }
+
+  int existingIndex = GetTextureIndex(texture);
+  if (existingIndex != -1) {
+    return existingIndex;
+  }
+
+  mTextures.push_back(texture);
+  return static_cast<int>(mTextures.size() - 1);
+}
+
+int Renderer::GetTextureIndex(Texture *texture) const {
+  for (size_t i = 0; i < mTextures.size(); i++) {
+    if (mTextures[i] == texture) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+Mesh *Renderer::LoadMesh(const std::string &meshName) {
+  auto it = mMeshCache.find(meshName);
+  if (it != mMeshCache.end()) {
+    return it->second;
+  }
+
+  Mesh *mesh = nullptr;
+  if (meshName == "cube") {
+    mesh = new CubeMesh();
+  } else if (meshName == "pyramid") {
+    mesh = new PyramidMesh();
+  } else if (meshName == "plane") {
+    mesh = new PlaneMesh();
+  } else if (meshName == "sphere") {
+    mesh = new SphereMesh();
+  } else if (meshName == "wall") {
+    mesh = new WallMesh();
+  } else {
+    std::cerr << "LoadMesh: unknown mesh name '" << meshName << "'"
+              << std::endl;
+    return nullptr;
+  }
+
+  mMeshCache[meshName] = mesh;
+  return mesh;
+}
+
+TextureAtlas *Renderer::LoadAtlas(const std::string &atlasPath) {
+  auto it = mAtlasCache.find(atlasPath);
+  if (it != mAtlasCache.end()) {
+    return it->second;
+  }
+
+  // Atlas metadata is plain JSON, so the real loader is used
+  TextureAtlas *atlas = new TextureAtlas(mAtlasCache.size());
+  if (atlas->Load(atlasPath)) {
+    mAtlasCache[atlasPath] = atlas;
+    return atlas;
+  }
+
+  delete atlas;
+  return nullptr;
+}
+
+GlyphAtlas *Renderer::LoadGlyphAtlas(const std::string &fontPath,
+                                     int pointSize) {
+  std::string key = fontPath + ":" + std::to_string(pointSize);
+  auto it = mGlyphAtlasCache.find(key);
+  if (it != mGlyphAtlasCache.end()) {
+    return it->second;
+  }
+
+  // Glyph layout is CPU work, so the real atlas is built (on a null texture)
+  GlyphAtlas *glyphs = new GlyphAtlas();
+  if (glyphs->Build(fontPath, pointSize, this)) {
+    mGlyphAtlasCache[key] = glyphs;
+    return glyphs;
+  }
+
+  delete glyphs;
+  return nullptr;
+}
+
+void Renderer::DrawMesh(MeshComponent &, RendererMode) {}
+
+void Renderer::DrawSprite(SpriteComponent &, RendererMode) {}
+
+// The buckets themselves are kept up to date (RenderBuckets.cpp is shared)
+void Renderer::PrepareBuckets() {}
+void Renderer::DrawMeshBuckets(bool, RendererMode) {}
+void Renderer::DrawSpriteBuckets(bool, RendererMode) {}
+void Renderer::DrawHUDSprites() {}
+
+// HUD layers are laid out (HUDLayout.cpp is shared) but have no textures
+void Renderer::DestroyHUDLayer(HUDLayer *layer) { delete layer; }
+
+// Static meshes still move to their chunks, no buffers are built
+void Renderer::BakeStaticGeometry() {
+  mDrawnMeshes.clear();
+  for (auto bucket : mRenderBuckets.GetMeshBuckets()) {
+    if (bucket->retained) {
+      mDrawnMeshes.insert(mDrawnMeshes.end(), bucket->components.begin(),
+                          bucket->components.end());
+    }
+  }
+  for (auto *meshComp : mDrawnMeshes) {
+    mRenderBuckets.Bake(meshComp, meshComp->GetOwner()->GetPosition());
+  }
+}
+
+// Nothing runs on a GPU
+GPUTimer::Stats Renderer::GetGPUPassStats(GPUPass) const {
+  return GPUTimer::Stats();
+}
+bool Renderer::WriteGPUPassStats(const std::string &) const { return false; }
+
+void Renderer::ActivateMeshShader() {}
+void Renderer::ActivateSpriteShader() {}
+void Renderer::ActivateMeshShaderNoLighting() {}
+void Renderer::ActivateSpriteShaderNoLighting() {}
+
+void Renderer::BeginDebugDraw() {}
+void Renderer::EndDebugDraw() {}
+void Renderer::DrawSingleMesh(Mesh *, const Vector3 &, const Vector3 &,
+                              const Quaternion &) {}
+
+void Renderer::SetViewMatrix(const Matrix4 &view) { mViewMatrix = view; }
+
+void Renderer::SetProjectionMatrix(const Matrix4 &projection) {
+  mProjectionMatrix = projection;
+}
+
+void Renderer::Clear() {}
+void Renderer::Present() {}
+
+void Renderer::BeginFramebuffer() {}
+void Renderer::EndFramebuffer() {}
+
+void Renderer::ApplyBloomBlur() {}
+void Renderer::SetBloomLevels(int levels) { mBloomLevels = levels; }
+
+void Renderer::AddUIElement(HUDElement *comp) { mUIComps.emplace_back(comp); }
+
+void Renderer::RemoveUIElement(HUDElement *comp) {
+  auto iter = std::find(mUIComps.begin(), mUIComps.end(), comp);
+  if (iter != mUIComps.end()) {
+    mUIComps.erase(iter);
+  }
+}
+
+void Renderer::setNight() {}
+void Renderer::setDay() {}
+void Renderer::setEvening() {}
@@ -0,0 +1,29 @@
+// Synth backend for the headless simulation benchmark. `synth` stays null, so
+// MIDIPlayer's direct fluid_synth_* calls are rejected by fluidsynth and no
+// audio driver is ever created.
+
+#include "MIDI/SynthEngine.hpp"
+
+fluid_settings_t *SynthEngine::settings = nullptr;
+fluid_synth_t *SynthEngine::synth = nullptr;
+fluid_audio_driver_t *SynthEngine::driver = nullptr;
+int SynthEngine::sfid = 0;
+
+void SynthEngine::init(const char *, const char *) {}
+
+void SynthEngine::clean() {}
+
+std::vector<std::pair<std::string, SoundPreset>>
+SynthEngine::getSoundPresets() {
+  return {};
+}
+
+void SynthEngine::setChannels(const std::vector<SoundPreset> &) {}
+
+void SynthEngine::startNote(unsigned int, unsigned int, unsigned int) {}
+
+void SynthEngine::stopNote(unsigned int, unsigned int) {}
+
+void SynthEngine::setPan(unsigned int, unsigned int) {}
+
+void SynthEngine::testSoundFont() {}
@@ -0,0 +1,25 @@
+// Texture backend for the headless simulation benchmark: records sizes, never
+// touches GL or decodes images.
+
+#include "render/Texture.hpp"
+
+Texture::Texture() : mTextureID(0), mWidth(0), mHeight(0) {}
+
+Texture::~Texture() { Unload(); }
+
+bool Texture::Load(const std::string &) { return true; }
+
+bool Texture::LoadFromSurface(SDL_Surface *surface) {
+  if (!surface) {
+    return false;
+  }
+  mWidth = surface->w;
+  mHeight = surface->h;
+  return true;
+}
+
+void Texture::Unload() {}
+
+void Texture::Bind(unsigned int) {}
+
+void Texture::Unbind() {}
@@ -0,0 +1,329 @@
+// Headless simulation benchmark.
+// Loads Level0-Level3 through their regular Initialize/LoadLevel paths and
+// drives the Game loop for a fixed number of frames at a fixed deltaTime,
+// without a window, GL context or audio driver.
+//
+// After the levels it checks that the broadphase makes the OnCollision calls
+// of the all-pairs loop on each level, and that the HUD layers are only
+// redrawn when a screen changed (Renderer::LayoutHUD). It fails if they do
+// not.
+//
+// Usage: mellodica_bench [--colliders N] [--all-pairs] [--serial]
+//                        [frames=600] [deltaTime=0.016667]
+//   --colliders N  run a synthetic scene with N box colliders (90% static)
+//                  instead of the levels
+//   --all-pairs    disable the collision broadphase (reference timings; the
+//                  collision callback totals must match)
+//   --serial       run the parallel update phase on the main thread only
+// Run from the repository root so that ./assets/ resolves.
+
+#include "AssetLoader.hpp"
+#include "Game.hpp"
+#include "UI/Screen/UIScreen.hpp"
+#include "actors/Actor.hpp"
+#include "actors/NoteActor.hpp"
+#include "actors/ShineActor.hpp"
+#include "components/ColliderComponent.hpp"
+#include "render/Renderer.hpp"
+#include "scenes/Scene.hpp"
+#include "scenes/Level0.hpp"
+#include "scenes/Level1.hpp"
+#include "scenes/Level2.hpp"
+#include "scenes/Level3.hpp"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_main.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Box used by the synthetic collider scene. Dynamic boxes wander around the
+// static grid. Penetrations are not applied, so positions never depend on the
+// collision path and the callback totals of both paths can be compared
+class StressBox : public Actor {
+public:
+  StressBox(Game *game, bool isStatic, const Vector3 &velocity, float bounds)
+      : Actor(game), mVelocity(velocity), mBounds(bounds) {
+    new AABBCollider(this,
+                     isStatic ? ColliderLayer::Ground : ColliderLayer::Entity,
+                     Vector3::Zero, Vector3(isStatic ? 0.5f : 0.3f), isStatic);
+    game->AddAlwaysActive(this);
+  }
+
+protected:
+  void OnUpdate(float deltaTime) override {
+    if (mVelocity.LengthSq() == 0.0f) {
+      return;
+    }
+
+    Vector3 pos = GetPosition() + mVelocity * deltaTime;
+    if (pos.x < -mBounds || pos.x > mBounds) {
+      mVelocity.x = -mVelocity.x;
+    }
+    if (pos.z < -mBounds || pos.z > mBounds) {
+      mVelocity.z = -mVelocity.z;
+    }
+    SetPosition(pos);
+  }
+
+private:
+  Vector3 mVelocity;
+  float mBounds;
+};
+
+// N colliders: a grid of static boxes with 10% dynamic boxes moving over it
+class StressScene : public Scene {
+public:
+  StressScene(Game *game, int colliders)
+      : Scene(game, scene0), mColliders(colliders) {}
+
+  void Initialize() override {
+    int dynamicCount = mColliders / 10;
+    int staticCount = mColliders - dynamicCount;
+    int side = static_cast<int>(std::ceil(std::sqrt(staticCount)));
+    const float spacing = 1.5f;
+    float bounds = side * spacing * 0.5f;
+
+    for (int i = 0; i < staticCount; i++) {
+      auto box = new StressBox(mGame, true, Vector3::Zero, bounds);
+      box->SetPosition(Vector3((i % side) * spacing - bounds, 0.0f,
+                               (i / side) * spacing - bounds));
+    }
+
+    // Fixed-seed LCG so every run (and both collision paths) is identical
+    unsigned int seed = 12345u;
+    auto random = [&seed]() {
+      seed = seed * 1664525u + 1013904223u;
+      return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    for (int i = 0; i < dynamicCount; i++) {
+      Vector3 velocity((random() - 0.5f) * 8.0f, 0.0f,
+                       (random() - 0.5f) * 8.0f);
+      auto box = new StressBox(mGame, false, velocity, bounds);
+      box->SetPosition(Vector3((random() * 2.0f - 1.0f) * bounds, 0.0f,
+                               (random() * 2.0f - 1.0f) * bounds));
+    }
+  }
+
+private:
+  int mColliders;
+};
+
+struct PhaseSamples {
+  const char *name;
+  std::vector<double> samples;
+};
+
+static void PrintPhase(const PhaseSamples &phase) {
+  std::vector<double> sorted = phase.samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  double sum = 0.0;
+  for (double s : sorted) {
+    sum += s;
+  }
+
+  size_t p99Index = static_cast<size_t>(
+      std::ceil(0.99 * static_cast<double>(sorted.size())));
+  p99Index = p99Index > 0 ? p99Index - 1 : 0;
+
+  std::printf("  %-18s %10.4f %10.4f %10.4f\n", phase.name, sorted.front(),
+              sum / static_cast<double>(sorted.size()), sorted[p99Index]);
+}
+
+static void RunLevel(Game &game, Scene *level, const char *name, int frames,
+                     float deltaTime) {
+  game.LoadScene(level);
+
+  PhaseSamples updateActors{"UpdateActors", {}};
+  PhaseSamples parallelUpdate{" ParallelUpdate", {}};
+  PhaseSamples findActive{"FindActiveActors", {}};
+  PhaseSamples collisions{"CheckCollisions", {}};
+  PhaseSamples total{"Total", {}};
+  size_t activeSum = 0, activeMax = 0;
+  size_t staticSum = 0, staticMax = 0;
+  size_t colliderSum = 0, colliderMax = 0;
+  size_t narrowphaseTests = 0;
+  size_t callbacks = 0;
+
+  for (int i = 0; i < frames; i++) {
+    game.StepSimulation(deltaTime);
+
+    const Game::FrameStats &stats = game.GetFrameStats();
+    updateActors.samples.push_back(stats.updateActorsMs);
+    parallelUpdate.samples.push_back(stats.parallelUpdateMs);
+    findActive.samples.push_back(stats.findActiveActorsMs);
+    collisions.samples.push_back(stats.collisionsMs);
+    total.samples.push_back(stats.updateActorsMs + stats.findActiveActorsMs +
+                            stats.collisionsMs);
+
+    activeSum += stats.activeActors;
+    activeMax = std::max(activeMax, stats.activeActors);
+    staticSum += stats.staticActors;
+    staticMax = std::max(staticMax, stats.staticActors);
+    colliderSum += stats.colliders;
+    colliderMax = std::max(colliderMax, stats.colliders);
+    narrowphaseTests += stats.narrowphaseTests;
+    callbacks += stats.collisionCallbacks;
+  }
+
+  std::printf("\n%s: %d frames, dt = %.6f s, %s, %d update workers\n", name,
+              frames, deltaTime,
+              game.IsUsingBroadphase() ? "broadphase" : "all-pairs",
+              game.IsUsingParallelUpdate() ? game.GetWorkerCount() : 0);
+  std::printf("  actors %zu, active mean %zu max %zu, static mean %zu max "
+              "%zu\n",
+              game.GetActorCount(), activeSum / frames, activeMax,
+              staticSum / frames, staticMax);
+  std::printf("  colliders mean %zu max %zu\n", colliderSum / frames,
+              colliderMax);
+  std::printf("  narrowphase tests %zu, collision callbacks %zu\n",
+              narrowphaseTests, callbacks);
+  const ActorPool<NoteActor> &notes = NoteActor::GetPool();
+  const ActorPool<ShineActor> &shines = ShineActor::GetPool();
+  std::printf("  note pool live %zu free %zu recycled %zu reused %zu, shine "
+              "pool live %zu free %zu recycled %zu reused %zu\n",
+              notes.GetLiveCount(), notes.GetFreeCount(),
+              notes.GetRecycledCount(), notes.GetReusedCount(),
+              shines.GetLiveCount(), shines.GetFreeCount(),
+              shines.GetRecycledCount(), shines.GetReusedCount());
+  std::printf("  %-18s %10s %10s %10s\n", "phase (ms)", "min", "mean", "p99");
+  PrintPhase(updateActors);
+  PrintPhase(parallelUpdate);
+  PrintPhase(findActive);
+  PrintPhase(collisions);
+  PrintPhase(total);
+}
+
+// The broadphase must make the OnCollision calls of the all-pairs loop, in
+// the same order, on every level. The levels run the all-pairs loop, which
+// counts the pairs with calls that the broadphase would not have resolved
+static bool CheckBroadphase(Game &game, int frames, float deltaTime) {
+  struct Level {
+    const char *name;
+    Scene *(*create)(Game *);
+  };
+  const Level levels[] = {
+      {"Level0", [](Game *game) -> Scene * { return new Level0(game); }},
+      {"Level1", [](Game *game) -> Scene * { return new Level1(game); }},
+      {"Level2", [](Game *game) -> Scene * { return new Level2(game); }},
+      {"Level3", [](Game *game) -> Scene * { return new Level3(game); }},
+  };
+
+  game.SetCheckBroadphase(true);
+  size_t missed = 0;
+  for (const Level &level : levels) {
+    game.LoadScene(level.create(&game));
+    size_t levelMissed = 0;
+    for (int i = 0; i < frames; i++) {
+      game.StepSimulation(deltaTime);
+      levelMissed += game.GetFrameStats().missedCollisionPairs;
+    }
+    if (levelMissed > 0) {
+      std::fprintf(stderr, "%s: the broadphase misses %zu colliding pairs\n",
+                   level.name, levelMissed);
+    }
+    missed += levelMissed;
+  }
+  game.SetCheckBroadphase(false);
+
+  std::printf("\nBroadphase check (%d frames per level): %zu colliding pairs "
+              "missed\n",
+              frames, missed);
+  return missed == 0;
+}
+
+// A screen's HUD layer is redrawn only when one of its sprites changed: a
+// frame like the one before redraws nothing, a new text redraws one layer
+static bool CheckHUDRedraws(Game &game, float deltaTime) {
+  const int width = 800;
+  const int height = 600;
+  Renderer *renderer = game.GetRenderer();
+
+  // A scene without screens of its own
+  game.LoadScene(new StressScene(&game, 10));
+  game.StepSimulation(deltaTime);
+
+  auto screen =
+      new UIScreen(&game, getAssetPath("fonts/MedodicaRegular.otf"));
+  TextElement *text =
+      screen->AddText("HP: 100/100", Color::White, Color::Black, 0.0f);
+  game.StepSimulation(deltaTime);
+  size_t first = renderer->LayoutHUD(width, height);
+
+  game.StepSimulation(deltaTime);
+  size_t unchanged = renderer->LayoutHUD(width, height);
+
+  text->SetText("HP: 99/100");
+  game.StepSimulation(deltaTime);
+  size_t changed = renderer->LayoutHUD(width, height);
+
+  screen->Close();
+  game.StepSimulation(deltaTime);
+
+  std::printf("\nHUD layers redrawn: first frame %zu, unchanged %zu, "
+              "changed text %zu\n",
+              first, unchanged, changed);
+  if (unchanged != 0 || changed != 1) {
+    std::fprintf(stderr, "HUD redraw check failed: expected 0 and 1\n");
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char **argv) {
+  int colliders = 0;
+  bool allPairs = false;
+  bool serial = false;
+  std::vector<const char *> positional;
+  for (int i = 1; i < argc; i++) {
+    if (std::strcmp(argv[i], "--colliders") == 0 && i + 1 < argc) {
+      colliders = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--all-pairs") == 0) {
+      allPairs = true;
+    } else if (std::strcmp(argv[i], "--serial") == 0) {
+      serial = true;
+    } else {
+      positional.push_back(argv[i]);
+    }
+  }
+
+  int frames = positional.size() > 0 ? std::atoi(positional[0]) : 600;
+  float deltaTime = positional.size() > 1
+                        ? static_cast<float>(std::atof(positional[1]))
+                        : 1.0f / 60.0f;
+  if (frames <= 0 || deltaTime <= 0.0f) {
+    std::fprintf(stderr,
+                 "usage: %s [--colliders N] [--all-pairs] [--serial] "
+                 "[frames] [deltaTime]\n",
+                 argv[0]);
+    return 1;
+  }
+
+  Game game;
+  if (!game.InitializeHeadless()) {
+    return 1;
+  }
+  game.SetUseBroadphase(!allPairs);
+  game.SetUseParallelUpdate(!serial);
+
+  if (colliders > 0) {
+    std::string name = "Stress (" + std::to_string(colliders) + " colliders)";
+    RunLevel(game, new StressScene(&game, colliders), name.c_str(), frames,
+             deltaTime);
+  } else {
+    RunLevel(game, new Level0(&game), "Level0", frames, deltaTime);
+    RunLevel(game, new Level1(&game), "Level1", frames, deltaTime);
+    RunLevel(game, new Level2(&game), "Level2", frames, deltaTime);
+    RunLevel(game, new Level3(&game), "Level3", frames, deltaTime);
+  }
+
+  bool collisionsChecked = CheckBroadphase(game, frames, deltaTime);
+  bool hudChecked = CheckHUDRedraws(game, deltaTime);
+
+  game.Shutdown();
+  return collisionsChecked && hudChecked ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class Actor;
+
+// The actors to update, maintained incrementally. Each reason for an actor to
+// be active (its chunk cell is in the query window, it is always-active) holds
+// a reference; the actor is a member while it has any. Membership is stored
+// in the actor (index and reference count), so there is no lookup structure
+// and no allocation once the member list has grown.
+class ActiveSet {
+public:
+  void Retain(Actor *actor);
+  void Release(Actor *actor);
+
+  // Drops all the references (the actor is being removed from the game)
+  void Remove(Actor *actor);
+
+  // Members, in no particular order. Changes when actors move between cells
+  const std::vector<Actor *> &GetActors() const { return mActors; }
+
+private:
+  void Erase(Actor *actor);
+
+  std::vector<Actor *> mActors;
+};
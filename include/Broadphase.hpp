@@ -0,0 +1,49 @@
+#pragma once
+#include "Math.hpp"
+#include "components/ColliderComponent.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Sweep-and-prune collision broadphase on the X axis.
+// Reports the collider pairs whose bounds overlap, so that only those reach
+// the narrowphase. Static-static pairs and pairs disabled in the layer mask are
+// never reported.
+class Broadphase {
+public:
+  // Returns (i, j) pairs, i < j, as indices into colliders. Pairs are sorted
+  // so they come out in the same order as an all-pairs i < j loop
+  const std::vector<std::pair<size_t, size_t>> &
+  FindPairs(const std::vector<ColliderComponent *> &colliders,
+            const CollisionMask &mask);
+
+  // True if collider i or j of the last FindPairs call is dynamic and moved
+  // out of its padded bounds. Collision responses move colliders during the
+  // pass, and the pairs of an escaped collider may then be missing. Only the
+  // resolved pair is checked: OnCollision moves its own actor only
+  bool HasEscaped(const std::vector<ColliderComponent *> &colliders, size_t i,
+                  size_t j) const;
+
+private:
+  struct Entry {
+    Vector3 min;
+    Vector3 max;
+    size_t index;
+    ColliderLayer layer;
+    bool isStatic;
+  };
+
+  // Remove entries that end before minX from an active list
+  static void Prune(std::vector<const Entry *> &active, float minX);
+
+  static bool Overlaps(const Entry &a, const Entry &b);
+  bool HasEscaped(const std::vector<ColliderComponent *> &colliders,
+                  size_t index) const;
+
+  // Buffers reused every frame to avoid reallocating
+  std::vector<Entry> mEntries;
+  std::vector<size_t> mEntryOf; // Position in mEntries of each collider
+  std::vector<const Entry *> mActiveStatic;
+  std::vector<const Entry *> mActiveDynamic;
+  std::vector<std::pair<size_t, size_t>> mPairs;
+};
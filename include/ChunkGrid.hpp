@@ -1,9 +1,12 @@
 #pragma once
 #include "Math.hpp"
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 class Actor;
+class ActiveSet;
 
 class ChunkGrid
 {
@@ -17,8 +20,24 @@ public:
     void UpdateActor(Actor* actor);  // Call when actor moves
     
     // Get actors in camera cell + adjacent cells (3x3 grid)
+    // Static actors are not included
     std::vector<Actor*> GetVisibleActors(const Vector3& cameraPos);
     
+    // Keeps the (non-static) actors of the query window cells in activeSet
+    void SetActiveSet(ActiveSet* activeSet) { mActiveSet = activeSet; }
+    
+    // Moves the query window to the cell + adjacent cells (3x3 grid) of each
+    // center. Only the cells that enter or leave it update the active set
+    void SetActiveWindow(const Vector3* centers, int count);
+    
+    // Static actors (terrain) are kept in separate per-cell lists and are only
+    // returned by GetStaticActors
+    void SetStatic(Actor* actor, bool isStatic);
+    
+    // Append the static actors within radius (on XZ) of any of the centers
+    void GetStaticActors(const Vector3* centers, int count, float radius,
+                         std::vector<Actor*>& outActors);
+    
     // Debug info
     int GetActiveCellCount() const;
     int GetTotalActorCount() const;
@@ -31,12 +50,20 @@ private:
     struct Cell
     {
         std::vector<Actor*> actors;
+        std::vector<Actor*> staticActors;
         int x, z;  // Cell coordinates
+        uint32_t windowStamp = 0; // In the window if == mWindowGeneration
     };
     
     void GetCellCoords(const Vector3& position, int& outX, int& outZ) const;
     int CoordsToIndex(int x, int z) const;
     
+    // The list of the cell that holds this actor's residency
+    std::vector<Actor*>& GetCellList(int cellIndex, Actor* actor);
+    
+    bool IsStatic(Actor* actor) const;
+    bool IsInWindow(int cellIndex) const;
+    
     // World bounds
     Vector3 mWorldMin;
     Vector3 mWorldMax;
@@ -49,4 +76,16 @@ private:
     
     // Track which cell each actor is in for fast updates
     std::unordered_map<Actor*, int> mActorCellMap;
+    
+    // Actors with static residency (may not be registered yet)
+    std::unordered_set<Actor*> mStaticActors;
+    
+    // Cells touched by the last GetStaticActors query
+    std::vector<int> mQueryCells;
+    
+    // Query window
+    ActiveSet* mActiveSet;
+    uint32_t mWindowGeneration;
+    std::vector<int> mWindowCells;
+    std::vector<int> mNewWindowCells;
 };
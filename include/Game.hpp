@@ -4,6 +4,9 @@
 #include "actors/Player.hpp"
 #include <SDL2/SDL.h>
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -11,6 +14,25 @@
 
 class Scene;
 
+// Static actors farther than this (on XZ) from the camera and the player are
+// culled. Covers the orthographic view with some margin
+constexpr float STATIC_CULL_RADIUS = 32.0f;
+
+// Fixed simulation steps per second, independent of the frame rate
+constexpr int SIMULATION_HZ = 60;
+// Target frame rate for FramePacing::Fixed
+constexpr int TARGET_FPS = 60;
+// Frames used for the frame-time (jitter) stats
+constexpr int FRAME_TIME_WINDOW = 120;
+// Active actors per job in the parallel update phase
+constexpr size_t PARALLEL_UPDATE_GRAIN = 128;
+
+enum class FramePacing {
+  Uncapped, // Render as fast as possible
+  VSync,    // The buffer swap waits for the display
+  Fixed     // Sleep (then spin) until the target frame time
+};
+
 class Game {
 public:
   Game();
@@ -18,6 +40,12 @@ public:
   bool Initialize();
   void RunLoop();
   void Shutdown();
+
+  // Headless setup: no window, GL context, audio driver or MIDI thread.
+  // Used by the simulation benchmark, which loads scenes itself
+  bool InitializeHeadless();
+  // Advance one simulation frame (MIDI + UpdateGame) with a fixed deltaTime
+  void StepSimulation(float deltaTime);
   void Quit() { mIsRunning = false; }
 
   // Actor functions
@@ -31,6 +59,12 @@ public:
   void AddAlwaysActive(class Actor *actor);
   void RemoveAlwaysActive(class Actor *actor);
 
+  // Static actors (terrain) are never updated. They are only drawn and
+  // collision-tested while within the static cull radius
+  void AddStaticActor(class Actor *actor);
+  float GetStaticCullRadius() const { return mStaticCullRadius; }
+  void SetStaticCullRadius(float radius) { mStaticCullRadius = radius; }
+
   // Renderer getter
   class Renderer *GetRenderer() { return mRenderer; }
 
@@ -43,9 +77,26 @@ public:
   // Debugging getter
   bool IsDebugging() const { return mIsDebugging; }
 
-  // Ticks count getter
+  // Simulated time in ms (advances by whole simulation steps)
   Uint32 GetTicksCount() const { return mTicksCount; }
 
+  // Simulation rate. UpdateGame always runs with deltaTime = 1 / Hz
+  int GetSimulationRate() const { return mSimulationRate; }
+  void SetSimulationRate(int hz);
+
+  // Frame pacing mode; targetFPS is only used by FramePacing::Fixed
+  FramePacing GetFramePacing() const { return mFramePacing; }
+  void SetFramePacing(FramePacing pacing, int targetFPS = TARGET_FPS);
+
+  // Last simulation step, and the fraction of the next one already elapsed
+  // when the frame is drawn (to interpolate transforms)
+  uint32_t GetSimulationStep() const { return mSimulationStep; }
+  float GetRenderAlpha() const { return mRenderAlpha; }
+
+  // Stamp given to the active and static actors by the last FindActiveActors
+  // (the Renderer only draws actors carrying it)
+  uint32_t GetRenderStamp() const { return mRenderStamp; }
+
   // Player getter
   Player *GetPlayer() { return mPlayer; }
   void SetPlayer(Player *player) { mPlayer = player; }
@@ -75,11 +126,78 @@ public:
   bool IsPaused() const { return mIsPaused; }
   void SetPaused(bool paused) { mIsPaused = paused; }
 
+  // Timings (in ms) and counts of the last simulated frame
+  struct FrameStats {
+    double updateActorsMs = 0.0; // UpdateActors, excluding FindActiveActors
+    double parallelUpdateMs = 0.0; // Parallel phase, part of updateActorsMs
+    double findActiveActorsMs = 0.0;
+    double collisionsMs = 0.0;
+    size_t activeActors = 0;
+    size_t staticActors = 0; // Static actors within the cull radius
+    size_t colliders = 0;
+    size_t narrowphaseTests = 0; // Intersect calls
+    size_t collisionCallbacks = 0; // OnCollision calls
+    // With SetCheckBroadphase: pairs that got OnCollision calls in the
+    // all-pairs loop but would not have been resolved by the broadphase
+    size_t missedCollisionPairs = 0;
+  };
+  const FrameStats &GetFrameStats() const { return mFrameStats; }
+
+  // Frame-time stats (in ms) over the last FRAME_TIME_WINDOW frames
+  struct FrameTimeStats {
+    double meanMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double jitterMs = 0.0; // Standard deviation
+    int frames = 0;
+  };
+  FrameTimeStats GetFrameTimeStats() const;
+  size_t GetActorCount() const { return mActors.size(); }
+
+  // Collision broadphase toggle (all-pairs is kept as a reference path)
+  bool IsUsingBroadphase() const { return mUseBroadphase; }
+  void SetUseBroadphase(bool useBroadphase) { mUseBroadphase = useBroadphase; }
+  // Collisions run the all-pairs loop and count the pairs the broadphase
+  // would have missed (FrameStats::missedCollisionPairs). For the bench
+  void SetCheckBroadphase(bool check) { mCheckBroadphase = check; }
+
+  // Parallel update phase toggle. When off, the phase still runs (same
+  // order and deferrals) but on the main thread only
+  bool IsUsingParallelUpdate() const { return mUseParallelUpdate; }
+  void SetUseParallelUpdate(bool useParallel) {
+    mUseParallelUpdate = useParallel;
+  }
+  int GetWorkerCount() const;
+
+  // True while the parallel update phase runs
+  bool IsUpdatingInParallel() const { return mUpdatingInParallel; }
+  // Runs fn on the main thread in the commit phase that follows the parallel
+  // update (in no particular order). Can be called from any thread
+  void DeferCommit(std::function<void()> fn);
+
 private:
+  void ProcessEvents();
   void ProcessInput();
   void UpdateGame(float deltaTime);
   void GenerateOutput();
+  void BeginSimulationStep(float deltaTime);
+  void WaitForFrameEnd(Uint64 frameStart);
+  void RecordFrameTime(double frameMs);
   void CheckCollisions();
+  void GatherActiveComponents();
+  void ResolveCollision(class ColliderComponent *colliderA,
+                        class ColliderComponent *colliderB);
+  // ResolveCollision of colliders i and j. Returns true if they got
+  // OnCollision calls
+  bool ResolvePair(const std::vector<class ColliderComponent *> &colliders,
+                   size_t i, size_t j);
+  // The all-pairs narrowphase in i < j order, from pair (i, j) on
+  void CheckAllPairs(const std::vector<class ColliderComponent *> &colliders,
+                     const class CollisionMask &mask, size_t i, size_t j);
+  // The all-pairs narrowphase, counting the pairs the broadphase would miss
+  void CheckBroadphasePairs(
+      const std::vector<class ColliderComponent *> &colliders,
+      const class CollisionMask &mask);
 
   // Track if we're updating actors right now
   bool mUpdatingActors;
@@ -90,8 +208,21 @@ private:
 
   // Always-active actors (updated/processed even when not visible)
   std::unordered_set<class Actor *> mAlwaysActiveActors;
+
+  // Actors in the chunk window or always-active, kept up to date by the
+  // ChunkGrid and the always-active functions. mActiveActors is the copy
+  // iterated during the frame
+  class ActiveSet *mActiveSet;
   std::vector<Actor *> mActiveActors;
 
+  // Static actors within the cull radius (drawn and collided, not updated)
+  std::vector<Actor *> mStaticActors;
+  float mStaticCullRadius;
+
+  // Colliders of the active and static actors, rebuilt with them
+  std::vector<class ColliderComponent *> mActiveColliders;
+  uint32_t mRenderStamp;
+
   // SDL window
   SDL_Window *mWindow;
 
@@ -104,6 +235,18 @@ private:
   // Chunk grid for efficient queries
   class ChunkGrid *mChunkGrid;
 
+  // Candidate pairs for CheckCollisions
+  class Broadphase *mBroadphase;
+  bool mUseBroadphase;
+  bool mCheckBroadphase;
+
+  // Parallel update phase
+  class JobSystem *mJobSystem;
+  bool mUseParallelUpdate;
+  bool mUpdatingInParallel;
+  std::mutex mDeferredMutex;
+  std::vector<std::function<void()>> mDeferredCommits;
+
   // Game Camera
   class Camera *mCamera;
 
@@ -119,10 +262,29 @@ private:
   // All UI screens in the game
   std::vector<class UIScreen *> mUIStack;
 
+  // Fixed-step simulation
+  int mSimulationRate;
+  double mSimulationTime; // In seconds, mTicksCount is derived from it
+  double mAccumulator;    // Real time not simulated yet
+  uint32_t mSimulationStep;
+  float mRenderAlpha;
+
+  // Frame pacing
+  FramePacing mFramePacing;
+  int mTargetFPS;
+  double mFrameTimes[FRAME_TIME_WINDOW];
+  int mFrameTimeCount;
+  int mFrameTimeIndex;
+  Uint64 mLastReportCounter;
+  size_t mReportedHUDRedraws;
+
   // Game state
   Uint32 mTicksCount;
   bool mIsRunning;
   bool mIsDebugging;
 
   bool mIsPaused;
+  bool mIsHeadless;
+
+  FrameStats mFrameStats;
 };
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool with one job queue per thread. Each thread takes jobs from the
+// back of its own queue and, when it runs dry, steals from the front of the
+// others. The calling thread works too while it waits for a ParallelFor.
+//
+// Only one thread (the main thread) may call ParallelFor, and jobs must not
+// call it again.
+class JobSystem {
+public:
+  // workerCount < 0: one worker per hardware thread, minus the main thread
+  explicit JobSystem(int workerCount = -1);
+  ~JobSystem();
+
+  int GetWorkerCount() const { return static_cast<int>(mWorkers.size()); }
+
+  // Calls fn(begin, end) for ranges of at most grainSize covering [0, count)
+  // and returns when all of them are done. Runs inline when there are no
+  // workers or a single range
+  void ParallelFor(size_t count, size_t grainSize,
+                   const std::function<void(size_t, size_t)> &fn);
+
+private:
+  struct Job {
+    const std::function<void(size_t, size_t)> *fn;
+    size_t begin;
+    size_t end;
+  };
+
+  struct JobQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  void WorkerLoop(size_t queueIndex);
+  // Pops from the back of queue queueIndex, or steals from another queue
+  bool TakeJob(size_t queueIndex, Job &job);
+  void RunJob(const Job &job);
+
+  std::vector<std::thread> mWorkers;
+
+  // Queue 0 belongs to the main thread, queue i + 1 to worker i
+  std::vector<std::unique_ptr<JobQueue>> mQueues;
+
+  // Jobs waiting in the queues (can briefly go negative while pushing)
+  std::atomic<int> mQueuedJobs;
+  // Jobs of the current ParallelFor not finished yet
+  std::atomic<int> mUnfinishedJobs;
+
+  std::mutex mWakeMutex;
+  std::condition_variable mWake;
+  bool mQuit;
+};
@@ -245,6 +245,14 @@ public:
     return Vector3(a.x + b.x, a.y + b.y, a.z + b.z);
   }
 
+  // Exact component-wise comparison
+  [[nodiscard]] friend bool operator==(const Vector3 &a, const Vector3 &b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+  }
+  [[nodiscard]] friend bool operator!=(const Vector3 &a, const Vector3 &b) {
+    return !(a == b);
+  }
+
   // Vector subtraction (a - b)
   [[nodiscard]] friend Vector3 operator-(const Vector3 &a, const Vector3 &b) {
     return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
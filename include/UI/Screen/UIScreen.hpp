@@ -10,6 +10,7 @@
 #include "../UIButton.hpp"
 #include "Game.hpp"
 #include "render/Renderer.hpp"
+#include <atomic>
 
 class UIScreen {
 public:
@@ -23,12 +24,14 @@ public:
   HUDElement *AddImageOrElement(const std::string &hudTexturePath,
                                 const std::string &hudAtlasPath) {
     auto hE = new HUDElement(mGame, hudTexturePath, hudAtlasPath);
+    hE->GetSpriteComponent().SetScreen(this);
     mHudImages.push_back(hE);
     return hE;
   }
 
   HUDElement *AddImageOrElement(const std::string &singleImagePath) {
     auto hE = new HUDElement(mGame, singleImagePath);
+    hE->GetSpriteComponent().SetScreen(this);
     mHudImages.push_back(hE);
     return hE;
   }
@@ -36,6 +39,7 @@ public:
     auto hE = new HUDElement(mGame);
     hE->GetSpriteComponent().SetColor(color);
     hE->GetSpriteComponent().SetTextureIndex(-1); // No texture, just color
+    hE->GetSpriteComponent().SetScreen(this);
     mHudImages.push_back(hE);
     return hE;
   }
@@ -44,6 +48,7 @@ public:
   TextElement *AddText(const std::string &text, const Vector3 &color,
                        const Vector3 &bgColor, float bgAlpha = 1.0f) {
     auto textElem = new TextElement(mGame, text, color, bgColor, bgAlpha);
+    textElem->GetSpriteComponent().SetScreen(this);
     mTextElements.push_back(textElem);
     return textElem;
   } // UI Buttons add
@@ -56,6 +61,12 @@ public:
 
   UIScreen::UIState GetUIState() const { return mState; }
 
+  // A HUD sprite of the screen changed (its setters mark it), the screen's
+  // layer is drawn again. Animations mark it from the parallel update
+  void MarkHUDDirty() { mHUDDirty = true; }
+  bool IsHUDDirty() const { return mHUDDirty; }
+  void ClearHUDDirty() { mHUDDirty = false; }
+
   virtual ~UIScreen();
 
   virtual void Update(float deltaTime);
@@ -71,6 +82,8 @@ protected:
   std::vector<HUDElement *> mHudImages;
   std::vector<UIButton *> mHudButtons;
   std::vector<TextElement *> mTextElements;
+
+  std::atomic<bool> mHUDDirty;
 };
 
 #endif // MELLODICA_UISCREEN_H
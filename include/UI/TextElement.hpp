@@ -4,7 +4,6 @@
 #include "../actors/Actor.hpp"
 #include "Math.hpp"
 #include "components/SpriteComponent.hpp"
-#include <SDL2/SDL_ttf.h>
 #include <string>
 #include <vector>
 
@@ -24,9 +23,12 @@ public:
   // SetScale to remember user scale
   void SetScale(const Vector3 &scale);
 
+  SpriteComponent &GetSpriteComponent() { return *mTextSprite; }
+
 private:
   void UpdateTextDisplay();
-  void RenderTextToTexture();
+  // Rebuilds the glyph quads of the sprite and its size
+  void LayoutText();
 
   std::string mText;
   Vector3 mTextColor;
@@ -35,14 +37,12 @@ private:
   Vector3 mUserScale; // User-defined scale override
   bool mHasUserScale; // Whether user has set a custom scale
 
-  // Text sprite (renders the text texture)
+  // Text sprite (draws the glyph quads)
   SpriteComponent *mTextSprite;
 
-  // Text texture
-  class Texture *mTextTexture;
-
-  static TTF_Font *sFont;
-  static int sFontRefCount;
+  // Glyphs of the font, shared by all text (owned by the Renderer)
+  class GlyphAtlas *mGlyphs;
+  std::vector<SpriteQuad> mQuads;
 };
 
 #endif
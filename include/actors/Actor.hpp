@@ -3,6 +3,7 @@
 #include "Input.hpp"
 #include "Math.hpp"
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <vector>
 
 enum class ActorState { Active, Paused, Destroy };
@@ -12,9 +13,21 @@ public:
   Actor(class Game *game);
   virtual ~Actor();
 
-  // Update function called from Game (not overridable)
+  // Update functions called from Game (not overridable). UpdateParallel runs
+  // on the job system for all active actors: the whole update of parallel
+  // actors, or the leading parallel-safe components of the others. Update
+  // then runs the rest serially
+  void UpdateParallel(float deltaTime);
   void Update(float deltaTime);
 
+  // Applies what the parallel update deferred (the ChunkGrid move)
+  void CommitParallelUpdate();
+
+  // Parallel actors promise that OnUpdate and all their components' Update
+  // only touch the actor's own data, read shared state without modifying it
+  // and leave spawning to Game::DeferCommit
+  bool IsParallelUpdate() const { return mParallelUpdate; }
+
   // ProcessInput function called from Game (not overridable)
   void ProcessInput();
 
@@ -24,11 +37,33 @@ public:
 
   // Scale getter/setter
   Vector3 GetScale() const { return mScale; }
-  void SetScale(const Vector3 scale) { mScale = scale; }
+  void SetScale(const Vector3 scale);
 
   // Rotation getter/setter (for 2D sprites, rotation around Y axis)
   Quaternion GetRotation() const { return mRotation; }
-  void SetRotation(const Quaternion rotation) { mRotation = rotation; }
+  void SetRotation(const Quaternion rotation);
+
+  // Static actors (terrain) are drawn and collided but never updated, and
+  // their meshes keep their instances between frames. Set by
+  // Game::AddStaticActor and Game::AddAlwaysActive. A static actor must only
+  // move through SetPosition/SetScale/SetRotation, which re-bake its meshes;
+  // writing mPosition directly leaves them drawn at the old place
+  bool IsStatic() const { return mIsStatic; }
+  void SetStatic(bool isStatic);
+
+  // Transform blended from the start to the end of the last simulation step
+  // by Game::GetRenderAlpha. Actors that were not snapshotted for that step
+  // (static, spawned or inactive) use their current transform
+  Vector3 GetRenderPosition() const;
+  Vector3 GetRenderScale() const;
+  Quaternion GetRenderRotation() const;
+
+  // Called by Game for the active actors before each simulation step
+  void SnapshotTransform(uint32_t step);
+
+  // Game::GetRenderStamp of the last FindActiveActors that found this actor
+  void SetRenderStamp(uint32_t stamp) { mRenderStamp = stamp; }
+  uint32_t GetRenderStamp() const { return mRenderStamp; }
 
   // State getter/setter
   ActorState GetState() const { return mState; }
@@ -45,16 +80,16 @@ public:
   // Called when the actor collides
   virtual void OnCollision(Vector3 penetration, ColliderComponent *other) {};
 
-  // Returns component of type T, or null if doesn't exist
+  // Called by Game instead of deleting a destroyed actor. Pooled actors
+  // detach themselves from the game and return true to be kept for reuse
+  virtual bool Recycle() { return false; }
+
+  // Returns the first component (in update order) of type T, or null if
+  // doesn't exist. T must be a component family with its own TYPE
   template <typename T> T *GetComponent() const {
-    for (auto c : mComponents) {
-
-      T *t = dynamic_cast<T *>(c);
-      if (t != nullptr) {
-        return t;
-      }
-    }
-    return nullptr;
+    static_assert(T::TYPE != ComponentType::Generic,
+                  "GetComponent needs a component type with a TYPE ID");
+    return static_cast<T *>(mFirstComponents[static_cast<int>(T::TYPE)]);
   }
 
 protected:
@@ -74,11 +109,43 @@ protected:
   Vector3 mScale;
   Quaternion mRotation;
 
+  // Transform at the start of simulation step mSnapshotStep
+  Vector3 mPrevPosition;
+  Vector3 mPrevScale;
+  Quaternion mPrevRotation;
+  uint32_t mSnapshotStep;
+  uint32_t mRenderStamp;
+
+  // Opt in to the parallel update phase (set in the constructor)
+  void SetParallelUpdate(bool parallel) { mParallelUpdate = parallel; }
+
   // Components
   std::vector<class Component *> mComponents;
 
+  // First component of each type in mComponents, for GetComponent
+  class Component *mFirstComponents[COMPONENT_TYPE_COUNT];
+
 private:
   friend class Component;
+  friend class ActiveSet;
+
+  // Position in Game's ActiveSet (-1 if not a member) and the number of
+  // reasons to be in it
+  int mActiveIndex;
+  int mActiveRefs;
+
+  // Transform changed: meshes of a static actor rebuild their instances and
+  // HUD sprites redraw their screen
+  void MarkDrawsDirty();
+
+  bool mIsStatic;
+
+  bool mParallelUpdate;
+  // Components already updated by UpdateParallel this step
+  size_t mParallelComponents;
+  bool mParallelDone;
+  // SetPosition during the parallel phase leaves the ChunkGrid to the commit
+  bool mChunkUpdatePending;
 
   // Adds component to Actor (called automatically in component constructor)
   void AddComponent(class Component *c);
@@ -0,0 +1,58 @@
+#ifndef ACTOR_POOL_HPP
+#define ACTOR_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+// Free list of destroyed actors of type T. Recycled actors keep their
+// components, so a pooled class only has to reset its state and register
+// with the Game again instead of reallocating everything.
+//
+// T's constructor/destructor report to OnCreated/OnDeleted, T::Recycle hands
+// destroyed actors to Release and T's spawn function tries Acquire first.
+template <typename T> class ActorPool {
+public:
+  // A recycled actor, or null if there is none
+  T *Acquire() {
+    if (mFree.empty()) {
+      return nullptr;
+    }
+    T *actor = mFree.back();
+    mFree.pop_back();
+    mReusedCount++;
+    return actor;
+  }
+
+  void Release(T *actor) {
+    mFree.push_back(actor);
+    mRecycledCount++;
+  }
+
+  // Delete the recycled actors (the Game must still be alive)
+  void Clear() {
+    std::vector<T *> actors;
+    actors.swap(mFree);
+    for (auto actor : actors) {
+      delete actor;
+    }
+  }
+
+  void OnCreated() { mInstanceCount++; }
+  void OnDeleted() { mInstanceCount--; }
+
+  // Actors in use (allocated and not waiting in the pool)
+  size_t GetLiveCount() const { return mInstanceCount - mFree.size(); }
+  // Actors waiting in the pool
+  size_t GetFreeCount() const { return mFree.size(); }
+  // Totals since startup
+  size_t GetRecycledCount() const { return mRecycledCount; }
+  size_t GetReusedCount() const { return mReusedCount; }
+
+private:
+  std::vector<T *> mFree;
+  size_t mInstanceCount = 0;
+  size_t mRecycledCount = 0;
+  size_t mReusedCount = 0;
+};
+
+#endif
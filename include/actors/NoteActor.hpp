@@ -2,6 +2,7 @@
 #define NOTEACTOR_HPP
 
 #include "Actor.hpp"
+#include "ActorPool.hpp"
 #include "components/ColliderComponent.hpp"
 #include "components/MeshComponent.hpp"
 #include "components/RigidBodyComponent.hpp"
@@ -30,18 +31,29 @@ public:
     mNotePlayerActor = NotePlayerActor;
   }
 
+  // Reuses a recycled note when there is one
+  static NoteActor *Spawn(NotePlayerActor *notePlayerActor, class Game *game,
+                          unsigned int midChannel, unsigned int midiNote,
+                          Vector3 direction = Vector3::UnitZ,
+                          Vector3 color = Color::White, float speed = 1.0f);
+  static ActorPool<NoteActor> &GetPool() { return sPool; }
+
   NotePlayerActor *GetNotePlayerActor() const { return mNotePlayerActor; }
 
   void Start();
   void OnUpdate(float deltaTime) override;
   void End();
   void OnCollision(Vector3 penetration, ColliderComponent *other) override;
+  bool Recycle() override;
 
   unsigned int GetMidiChannel() const { return mMidiChannel; }
   unsigned int GetNote() const { return mMidiNote; }
   Vector3 GetDirection() const { return mDirection; }
 
 private:
+  void Reset(unsigned int midChannel, unsigned int midiNote, Vector3 direction,
+             Vector3 color, float speed);
+
   unsigned int mMidiChannel;
   unsigned int mMidiNote;
   bool mIsPlaying;
@@ -56,5 +68,7 @@ private:
   MeshComponent *mMeshComponent;
 
   NotePlayerActor *mNotePlayerActor;
+
+  static ActorPool<NoteActor> sPool;
 };
 #endif
\ No newline at end of file
@@ -36,6 +36,8 @@ class MovableBox : public SolidCubeActor {
 public:
   MovableBox(Game *game, const Vector3 &color = Vector3(0.5f))
       : SolidCubeActor(game, color, 8), mIsInHole(false) {
+    // Pushed and updated, unlike the static cubes it is built from
+    mGame->AddAlwaysActive(this);
     mColliderComponent->SetStatic(false);
     if (mGame->GetCurrentScene()->GetSceneID() == Scene::SceneEnum::scene2) {
       mMeshComponent->SetBloomed(true);
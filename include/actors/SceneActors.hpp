@@ -31,9 +31,11 @@ protected:
   MeshComponent *mMeshComponent;
 };
 
-class Hole : public GroundActor {
+// Collision of a hole or water rectangle. Its surface is drawn by the
+// renderer's GroundTilemap, only the battle border is a mesh of its own
+class Hole : public Actor {
 public:
-  Hole(Game *game, const Vector3 &color = Color::Black);
+  Hole(Game *game);
 
   void OnUpdate(float deltaTime) override;
 
@@ -42,28 +44,6 @@ private:
   MeshComponent *mBorder;
 };
 
-class Water : public Hole {
-public:
-  Water(Game *game, const Vector3 &color = Vector3(0.0f, 0.5f, 1.0f))
-      : Hole(game, color), mAnimTimer(0.0f), mCurrentFrame(0) {
-    mMeshComponent->SetBloomed(false);
-  }
-
-  void OnUpdate(float deltaTime) override;
-
-private:
-  float mAnimTimer;
-  unsigned int mCurrentFrame;
-};
-
-class MagicWater : public Water {
-public:
-  MagicWater(Game *game, const Vector3 &color = Vector3(0.5f, 0.0f, 1.0f))
-      : Water(game, color) {
-    mMeshComponent->SetBloomed(true);
-  }
-};
-
 // Simple pyramid actor with MeshComponent
 class PyramidActor : public Actor {
 public:
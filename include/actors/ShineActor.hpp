@@ -2,18 +2,33 @@
 #define SHINE_ACTOR_HPP
 
 #include "Actor.hpp"
+#include "ActorPool.hpp"
 
 class ShineActor : public Actor {
 public:
   ShineActor(class Game *game, Vector3 color, bool autoDestroy = true);
+  ~ShineActor();
+
+  // Reuses a recycled shine when there is one
+  static ShineActor *Spawn(class Game *game, Vector3 color,
+                           bool autoDestroy = true);
+  static ActorPool<ShineActor> &GetPool() { return sPool; }
+
   void OnUpdate(float deltaTime) override;
+  bool Recycle() override;
 
   void Start(float lifetime);
-  void SetAutoDestroy(bool autoDestroy) { mAutoDestroy = autoDestroy; }
+  // A shine that already finished is destroyed right away
+  void SetAutoDestroy(bool autoDestroy);
 
 private:
+  void Reset(Vector3 color, bool autoDestroy);
+
   class SpriteComponent *mSpriteComponent;
   float mLifetime;
   bool mAutoDestroy;
+  bool mFinished;
+
+  static ActorPool<ShineActor> sPool;
 };
 #endif
\ No newline at end of file
@@ -3,14 +3,50 @@
 
 #include "Component.hpp"
 #include "Math.hpp"
+#include <cstdint>
 
 enum class ColliderType { AABB, OBB, Sphere };
 
 enum class ColliderLayer { Player, Ground, Hole, Entity, Enemy, Note };
 
+const int COLLIDER_LAYER_COUNT = 6;
+
+// Symmetric layer-vs-layer table of the collider pairs that are tested at all.
+// Disabled pairs are rejected before any bounds or narrowphase test
+class CollisionMask {
+public:
+  // Every pair enabled
+  CollisionMask() {
+    for (int i = 0; i < COLLIDER_LAYER_COUNT; i++) {
+      mRows[i] = (1u << COLLIDER_LAYER_COUNT) - 1u;
+    }
+  }
+
+  void Set(ColliderLayer a, ColliderLayer b, bool collides) {
+    int i = static_cast<int>(a);
+    int j = static_cast<int>(b);
+    if (collides) {
+      mRows[i] |= static_cast<uint8_t>(1u << j);
+      mRows[j] |= static_cast<uint8_t>(1u << i);
+    } else {
+      mRows[i] &= static_cast<uint8_t>(~(1u << j));
+      mRows[j] &= static_cast<uint8_t>(~(1u << i));
+    }
+  }
+
+  bool Collides(ColliderLayer a, ColliderLayer b) const {
+    return (mRows[static_cast<int>(a)] >> static_cast<int>(b)) & 1u;
+  }
+
+private:
+  uint8_t mRows[COLLIDER_LAYER_COUNT];
+};
+
 // Collider component interface
 class ColliderComponent : public Component {
 public:
+  static constexpr ComponentType TYPE = ComponentType::Collider;
+
   ColliderComponent(Actor *owner, ColliderLayer layer,
                     ColliderType type = ColliderType::AABB,
                     bool isStatic = false, int updateOrder = 10);
@@ -24,6 +60,9 @@ public:
   // implementations)
   virtual Vector3 DetectCollision(const ColliderComponent &other) const = 0;
 
+  // World-space box enclosing the collider (used by the collision broadphase)
+  virtual void GetBounds(Vector3 &outMin, Vector3 &outMax) const = 0;
+
   // Debug draw the collider bounds (virtual to allow different implementations)
   virtual void DebugDraw(class Renderer *renderer) override = 0;
 
@@ -47,6 +86,7 @@ public:
 
   bool Intersect(const ColliderComponent &other) const override;
   Vector3 DetectCollision(const ColliderComponent &other) const override;
+  void GetBounds(Vector3 &outMin, Vector3 &outMax) const override;
   void DebugDraw(class Renderer *renderer) override;
 
   Vector3 GetOffset() const { return mOffset; }
@@ -70,6 +110,7 @@ public:
 
   bool Intersect(const ColliderComponent &other) const override;
   Vector3 DetectCollision(const ColliderComponent &other) const override;
+  void GetBounds(Vector3 &outMin, Vector3 &outMax) const override;
   void DebugDraw(class Renderer *renderer) override;
 
   Vector3 GetOffset() const { return mOffset; }
@@ -92,6 +133,7 @@ public:
 
   bool Intersect(const ColliderComponent &other) const override;
   Vector3 DetectCollision(const ColliderComponent &other) const override;
+  void GetBounds(Vector3 &outMin, Vector3 &outMax) const override;
   void DebugDraw(class Renderer *renderer) override;
 
   Vector3 GetOffset() const { return mOffset; }
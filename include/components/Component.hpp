@@ -2,10 +2,20 @@
 #include "Input.hpp"
 #include <SDL2/SDL.h>
 
+// Component type IDs, one per component family. Each family declares its ID
+// as TYPE; GetComponent<T> and the per-type lists in Game use it instead of
+// RTTI
+enum class ComponentType { Generic, Mesh, Sprite, Collider, RigidBody, Melody };
+
+const int COMPONENT_TYPE_COUNT = 6;
+
 class Component {
 public:
+  static constexpr ComponentType TYPE = ComponentType::Generic;
+
   // Constructor (lower update order = earlier update)
-  Component(class Actor *owner, int updateOrder = 100);
+  Component(class Actor *owner, int updateOrder = 100,
+            ComponentType type = ComponentType::Generic);
   virtual ~Component();
 
   // Update this component by delta time
@@ -18,14 +28,22 @@ public:
   virtual void DebugDraw(class Renderer *renderer) {};
 
   int GetUpdateOrder() const { return mUpdateOrder; }
+  ComponentType GetComponentType() const { return mComponentType; }
   class Actor *GetOwner() const { return mOwner; }
   class Game *GetGame() const;
 
   void SetEnabled(bool enabled) { mIsEnabled = enabled; }
   bool IsEnabled() const { return mIsEnabled; }
 
+  // Parallel-safe components have an Update that only touches their own and
+  // their owner's data. They run in the parallel update phase when they come
+  // before any other component of their owner (see Actor::UpdateParallel)
+  bool IsParallelUpdate() const { return mParallelUpdate; }
+
 protected:
   class Actor *mOwner;
   int mUpdateOrder;
   bool mIsEnabled;
+  ComponentType mComponentType;
+  bool mParallelUpdate;
 };
@@ -4,25 +4,52 @@
 
 class DrawComponent : public Component {
 public:
-  DrawComponent(class Actor *owner);
+  DrawComponent(class Actor *owner, ComponentType type);
   ~DrawComponent();
 
-  void SetVisible(bool visible) { mIsVisible = visible; }
+  void SetVisible(bool visible);
   bool IsVisible() const { return mIsVisible; }
 
-  void SetBloomed(bool bloomed) { mIsBloomed = bloomed; }
-  bool IsBloomed() { return mIsBloomed; }
+  void SetBloomed(bool bloomed);
+  bool IsBloomed() const { return mIsBloomed; }
 
-  void SetColor(Vector3 color) { mColor = color; }
+  // Setting the current value does nothing
+  void SetColor(Vector3 color) {
+    if (color != mColor) {
+      mColor = color;
+      MarkDirty();
+    }
+  }
   Vector3 &GetColor() { return mColor; }
 
-  void SetOffset(Vector3 offset) { mOffset = offset; }
+  void SetOffset(Vector3 offset) {
+    if (offset != mOffset) {
+      mOffset = offset;
+      MarkDirty();
+    }
+  }
   Vector3 &GetOffset() { return mOffset; }
 
-  void SetScale(Vector3 scale) { mScale = scale; }
+  void SetScale(Vector3 scale) {
+    if (scale != mScale) {
+      mScale = scale;
+      MarkDirty();
+    }
+  }
   Vector3 &GetScale() { return mScale; }
 
+  // Draw state changed (the setters call it). Only what is kept drawn between
+  // frames needs it: meshes of static actors and the HUD sprites of a screen
+  virtual void MarkDirty() {}
+
+  // Calls UpdateRenderBucket now, or in the commit phase when called from the
+  // parallel update (the buckets are shared)
+  void RefileRenderBucket();
+
 protected:
+  // Moves the component to the render bucket of its current state
+  virtual void UpdateRenderBucket() {}
+
   bool mIsVisible;
   bool mIsBloomed;
   Vector3 mColor;
@@ -5,6 +5,8 @@
 
 class MelodyComponent : public Component {
 public:
+  static constexpr ComponentType TYPE = ComponentType::Melody;
+
   // TODO: review these constants
   static constexpr int SIGMA = 12;             // Alphabet size for melodies
   static constexpr float DEFAULT_TIMER = 5.0f; // Default timer for matching
@@ -7,22 +7,57 @@
 
 class MeshComponent : public DrawComponent {
 public:
+  static constexpr ComponentType TYPE = ComponentType::Mesh;
+
   MeshComponent(class Actor *owner, Mesh &mesh, Texture *texture = nullptr,
                 TextureAtlas *textureAtlas = nullptr, int startingIndex = -1);
   ~MeshComponent();
 
+  // A baked mesh leaves its chunk to be drawn with the change
+  void MarkDirty() override {
+    mInstanceDirty = true;
+    if (mChunk) {
+      RefileRenderBucket();
+    }
+  }
+
   Mesh &GetMesh() const { return mMesh; }
   TextureAtlas *GetTextureAtlas() const { return mTextureAtlas; }
   int GetStartingIndex() const { return mStartingIndex; }
-  void SetTextureIndex(int index) { mStartingIndex = index; }
+  void SetTextureIndex(int index) {
+    mStartingIndex = index;
+    MarkDirty();
+  }
 
-  void SetRelativeRotation(Quaternion relRot) { mRelativeRotation = relRot; }
+  void SetRelativeRotation(Quaternion relRot) {
+    mRelativeRotation = relRot;
+    MarkDirty();
+  }
   Quaternion &GetRelativeRotation() { return mRelativeRotation; }
 
 protected:
+  void UpdateRenderBucket() override;
+
   Quaternion mRelativeRotation;
   Mesh &mMesh;
   Texture *mTexture;
   TextureAtlas *mTextureAtlas;
   int mStartingIndex;
+
+private:
+  friend class RenderBuckets;
+  friend class Renderer;
+
+  // Position in the Renderer's buckets (null while hidden)
+  struct MeshBucket *mBucket;
+  size_t mBucketIndex;
+  // Static chunk the mesh is baked in, instead of a bucket
+  struct StaticChunk *mChunk;
+  size_t mChunkIndex;
+
+  // Instance and world bounds kept by retained buckets, rebuilt when dirty
+  MeshInstance mInstance;
+  Vector3 mBoundsCenter;
+  Vector3 mBoundsExtents;
+  bool mInstanceDirty;
 };
@@ -8,6 +8,8 @@
 class RigidBodyComponent : public Component {
 
     public:
+        static constexpr ComponentType TYPE = ComponentType::RigidBody;
+
         RigidBodyComponent(class Actor* owner, float mass = 1.0f, float friction = 0.0f, bool applyGravity = false, int updateOrder = 10);
         virtual ~RigidBodyComponent();
 
@@ -4,8 +4,18 @@
 #include <unordered_map>
 #include <vector>
 
+// Part of a HUD sprite: center and size as fractions of the sprite's rect
+// (its center at 0, y up) and a tint applied on top of the sprite color
+struct SpriteQuad {
+  Vector4 rect; // Center xy, size zw
+  Vector4 tint; // rgba
+  int tileIndex;
+};
+
 class SpriteComponent : public DrawComponent {
 public:
+  static constexpr ComponentType TYPE = ComponentType::Sprite;
+
   // Constructor for sprite with atlas (animated or static)
   // isHUD: if true, sprite is drawn in screen space after framebuffer rendering
   SpriteComponent(class Actor *owner, int textureIndex,
@@ -23,16 +33,21 @@ public:
                     const std::vector<std::string> &frameNames,
                     bool repeat = true);
 
-  void SetAnimationTimer(float time) { mAnimTimer = time; }
+  void SetAnimationTimer(float time) {
+    if (time != mAnimTimer) {
+      mAnimTimer = time;
+      MarkDirty();
+    }
+  }
   float GetAnimationTimer() const { return mAnimTimer; }
 
   // Atlas controls
-  void SetTextureAtlas(class TextureAtlas *atlas) { mTextureAtlas = atlas; }
+  void SetTextureAtlas(class TextureAtlas *atlas);
   class TextureAtlas *GetTextureAtlas() const { return mTextureAtlas; }
 
   // Get texture index (in renderer's texture array)
   int GetTextureIndex() const { return mTextureIndex; }
-  void SetTextureIndex(int idx) { mTextureIndex = idx; }
+  void SetTextureIndex(int idx);
 
   // Get current tile index (accounting for animations)
   int GetCurrentTileIndex() const;
@@ -40,7 +55,31 @@ public:
   // HUD sprite flag
   bool IsHUD() const { return mIsHUD; }
 
+  // HUD sprites drawn as several tiles of their atlas (text). Without quads
+  // the sprite is a single quad
+  void SetQuads(const std::vector<SpriteQuad> &quads) {
+    mQuads = quads;
+    MarkDirty();
+  }
+  const std::vector<SpriteQuad> &GetQuads() const { return mQuads; }
+
+  // UI screen the HUD sprite belongs to. A screen's sprites are drawn together
+  // into its layer (see Renderer::DrawHUDSprites)
+  void SetScreen(class UIScreen *screen) {
+    mScreen = screen;
+    MarkDirty();
+  }
+  class UIScreen *GetScreen() const { return mScreen; }
+
+  // A HUD sprite's screen is drawn again
+  void MarkDirty() override;
+
+protected:
+  void UpdateRenderBucket() override;
+
 private:
+  friend class RenderBuckets;
+
   // Texture index in renderer (for animated sprites) or tile index (for static
   // sprites)
   int mTextureIndex;
@@ -67,10 +106,16 @@ private:
 
   // HUD sprite flag (if true, rendered in screen space after framebuffer)
   bool mIsHUD;
+  std::vector<SpriteQuad> mQuads;
+  class UIScreen *mScreen;
 
   // 2D rotation in radians (applied after billboarding, around camera's Z-axis)
   float mRotation;
 
+  // Position in the Renderer's buckets (null while hidden)
+  struct SpriteBucket *mBucket;
+  size_t mBucketIndex;
+
 public:
   void SetRotation(float rotation) { mRotation = rotation; }
   float GetRotation() const { return mRotation; }
@@ -1,6 +1,7 @@
 #pragma once
 #include "actors/Actor.hpp"
 #include "Math.hpp"
+#include "render/Frustum.hpp"
 
 enum class CameraMode {
   Isometric, // Camera is following a target position, with isometric direction
@@ -32,6 +33,12 @@ public:
   // Sets the Renderer ViewMatrix to current Position and Rotation of Camera
   void Update(float deltaTime);
 
+  // Keep the current transform as the start of the next simulation step
+  void SnapshotTransform();
+  // Sets the ViewMatrix blended from the start to the end of the last
+  // simulation step (alpha in [0, 1])
+  void UpdateViewMatrix(float alpha);
+
   // Get/set position instantly
   Vector3 GetPosition() const { return mPosition; }
   void SetPosition(const Vector3 &pos) { mPosition = pos; }
@@ -58,6 +65,9 @@ public:
     mIsometricDirection = direction;
   }
 
+  // World-space view frustum of the last view matrix set on the Renderer
+  const Frustum &GetFrustum() const { return mFrustum; }
+
   // Get mode
   CameraMode GetMode() const { return mMode; }
   void SetMode(const CameraMode mode) { mMode = mode; }
@@ -93,14 +103,24 @@ private:
   Vector3 mPosition;
   Quaternion mRotation;
 
+  // Transform at the start of the last simulation step
+  Vector3 mPrevPosition;
+  Quaternion mPrevRotation;
+
   Vector3 mTargetPosition;
   Quaternion mTargetRotation;
 
   CameraMode mMode;
+  Frustum mFrustum;
 
   float mMoveSpeed;
   float mTurnSpeed;
   IsometricDirections mIsometricDirection;
 
+  // Sets the Renderer ViewMatrix and the frustum
+  void ApplyViewMatrix(const Matrix4 &view);
+
   Matrix4 GetCameraMatrix() const;
+  static Matrix4 GetCameraMatrix(const Vector3 &position,
+                                 const Quaternion &rotation);
 };
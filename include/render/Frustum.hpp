@@ -0,0 +1,34 @@
+#pragma once
+#include "Math.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Axis-aligned boxes (center and half extents) stored as separate arrays, so
+// the frustum test runs over contiguous floats
+struct BoundsArray {
+  std::vector<float> centerX, centerY, centerZ;
+  std::vector<float> extentX, extentY, extentZ;
+
+  void Resize(size_t count);
+  void Set(size_t index, const Vector3 &center, const Vector3 &extents);
+};
+
+// Clip volume of a (row-vector) view-projection matrix, as six planes facing
+// inwards. With a projection alone it is the view-space volume
+class Frustum {
+public:
+  // Everything is inside until a matrix is set
+  Frustum();
+  explicit Frustum(const Matrix4 &viewProjection);
+
+  bool Intersects(const Vector3 &center, const Vector3 &extents) const;
+
+  // Writes 1 to visible[i] for each of the first count boxes that is inside
+  // or crosses the frustum, 0 for the others. Returns the visible count
+  size_t Cull(const BoundsArray &bounds, size_t count, uint8_t *visible) const;
+
+private:
+  // a, b, c, d with ax + by + cz + d >= 0 inside
+  float mPlanes[6][4];
+};
@@ -0,0 +1,52 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+
+// Shadow of the GL bindings and raster state the renderer changes. A change
+// to what is already set is skipped, so draw loops can set what they need
+// per group without paying for a driver call each time. There is a single
+// GL context, so the cache is global. Everything that binds programs,
+// textures, vertex arrays or framebuffers goes through it.
+class GLState {
+public:
+  static void UseProgram(GLuint program);
+  static void BindTexture(GLuint unit, GLuint texture,
+                          GLenum target = GL_TEXTURE_2D);
+  static void BindVertexArray(GLuint vertexArray);
+  static void BindFramebuffer(GLuint framebuffer);
+
+  // GL_DEPTH_TEST, GL_CULL_FACE or GL_BLEND
+  static void SetEnabled(GLenum capability, bool enabled);
+  // GL_FILL or GL_LINE, for both faces
+  static void SetPolygonMode(GLenum mode);
+
+  // Forgets the cached state, for after the context is created or objects
+  // are deleted (deleting a bound object unbinds it and its name may be
+  // reused)
+  static void Invalidate();
+
+  // State calls sent to GL and skipped as redundant since the last reset
+  static size_t GetCallCount() { return sCalls; }
+  static size_t GetSkippedCount() { return sSkipped; }
+  static void ResetCounters();
+
+private:
+  static constexpr int TEXTURE_UNITS = 8;
+  static constexpr GLuint UNKNOWN = ~0u;
+
+  // Counts the call, returns whether it has to be sent
+  static bool Change(GLuint &cached, GLuint value);
+
+  static GLuint sProgram;
+  static GLuint sActiveUnit;
+  static GLuint sTextures[TEXTURE_UNITS];
+  static GLuint sVertexArray;
+  static GLuint sFramebuffer;
+  static GLuint sDepthTest;
+  static GLuint sCullFace;
+  static GLuint sBlend;
+  static GLuint sPolygonMode;
+
+  static size_t sCalls;
+  static size_t sSkipped;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <string>
+
+// Renderer passes timed on the GPU, in frame order
+enum class GPUPass {
+  Clear,          // BeginFramebuffer
+  Meshes,         // Lit meshes, scene and bloom targets together
+  BloomedMeshes,  // Unlit bloomed meshes
+  Debug,          // Collider wireframes
+  Sprites,        // Lit sprites
+  BloomedSprites, // Unlit bloomed sprites
+  BloomBlur,      // ApplyBloomBlur
+  Composite,      // EndFramebuffer
+  HUD,            // DrawHUDSprites (layer redraws and compositing)
+  Count
+};
+
+inline const char *GetGPUPassName(GPUPass pass) {
+  static const char *names[] = {"clear",           "meshes",
+                                "bloomed_meshes",  "debug",
+                                "sprites",         "bloomed_sprites",
+                                "bloom_blur",      "composite",
+                                "hud"};
+  return names[static_cast<int>(pass)];
+}
+
+// GL_TIME_ELAPSED queries around each pass. There are two sets of queries:
+// a frame issues one while the results of the other, from the frame before,
+// are collected at its end. A result that is not ready by then is dropped
+// rather than waited for, so timing never stalls the pipeline. Passes are
+// timed one at a time (elapsed time queries don't nest).
+class GPUTimer {
+public:
+  GPUTimer();
+  ~GPUTimer();
+
+  bool Initialize();
+  void Shutdown();
+
+  // Around one pass. A pass not run in a frame has no sample for it
+  void Begin(GPUPass pass);
+  void End();
+
+  // Call after the last pass of a frame
+  void EndFrame();
+
+  // Pass times over the last SAMPLES frames it ran in, in milliseconds
+  struct Stats {
+    size_t samples = 0;
+    double minMs = 0.0;
+    double meanMs = 0.0;
+    double maxMs = 0.0;
+  };
+  Stats GetStats(GPUPass pass) const;
+
+  // One line per pass: pass,samples,min_ms,mean_ms,max_ms
+  bool WriteCSV(const std::string &path) const;
+
+private:
+  static constexpr int PASS_COUNT = static_cast<int>(GPUPass::Count);
+  static constexpr int SAMPLES = 120;
+
+  GLuint mQueries[2][PASS_COUNT];
+  bool mIssued[2][PASS_COUNT];
+  int mSet;
+  int mActivePass; // -1 between passes
+  bool mInitialized;
+  bool mCollected; // Whether a frame was read yet
+
+  // Ring of the last samples of each pass
+  double mSamples[PASS_COUNT][SAMPLES];
+  int mSampleCount[PASS_COUNT];
+  int mSampleIndex[PASS_COUNT];
+};
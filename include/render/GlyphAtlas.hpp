@@ -0,0 +1,45 @@
+#pragma once
+#include "Math.hpp"
+#include "components/SpriteComponent.hpp"
+#include <string>
+#include <vector>
+
+// The glyphs of a font at one size, rasterized once into a grid texture.
+// Text is laid out as one quad per glyph, so changing a string or its color
+// only rebuilds the quads. Covers Latin-1 (ASCII and the Portuguese accents),
+// other characters are drawn as '?'
+class GlyphAtlas {
+public:
+  GlyphAtlas();
+  ~GlyphAtlas();
+
+  // Renders the glyphs and registers their texture with the renderer
+  bool Build(const std::string &fontPath, int pointSize,
+             class Renderer *renderer);
+
+  // Appends the quads of a (possibly multi-line) UTF-8 string, as fractions of
+  // the text's rect, and returns the rect's size in pixels
+  void Layout(const std::string &text, const Vector4 &tint,
+              std::vector<SpriteQuad> &quads, int &width, int &height) const;
+
+  class TextureAtlas *GetAtlas() const { return mAtlas; }
+  int GetTextureIndex() const { return mTextureIndex; }
+
+  // Opaque white tile, for backgrounds
+  static constexpr int SOLID_TILE = 0;
+
+private:
+  // Glyph slot of a code point, '?' if the font does not have it
+  int GetSlot(unsigned int codePoint) const;
+
+  class TextureAtlas *mAtlas;
+  int mTextureIndex;
+
+  // Glyph cell size without the one-texel border, in pixels
+  int mGlyphWidth;
+  int mGlyphHeight;
+  int mLineSkip;
+
+  // Pen advance per slot, -1 for glyphs missing from the font
+  std::vector<int> mAdvances;
+};
@@ -0,0 +1,87 @@
+#pragma once
+#include "Math.hpp"
+#include <cstdint>
+#include <vector>
+
+class TextureAtlas;
+
+// What covers a ground cell. Holes and water are drawn by the tilemap, their
+// collision stays with the Hole actors
+enum class GroundKind : int16_t {
+  Empty,
+  Ground,
+  Hole,
+  Water,
+  MagicWater,
+  Count
+};
+
+// How the cells of a kind are drawn
+struct GroundMaterial {
+  Vector3 color;
+  bool bloomed;
+  // Animated kinds step from the cell's tile through the next frames - 1
+  // tiles, frameTime seconds each
+  int frames;
+  float frameTime;
+  // Raised by the tilemap's lift (holes above the battle field)
+  bool lifted;
+};
+
+// One texel of the tile-ID texture (GL_RG16I)
+struct GroundCell {
+  int16_t tileIndex; // -1 for a flat color
+  int16_t kind;      // GroundKind
+};
+
+// A corner of a cell's quad, the attributes of Ground.vert
+struct GroundVertex {
+  int16_t cell[2];   // Column, row
+  int16_t corner[2]; // 0 or 1 along the column and the row
+};
+
+// The floor of a level, one cell per terrain CSV cell. Cell (column, row)
+// covers x in [column - 0.5, column + 0.5] and z in [-row - 0.5, -row + 0.5]
+// at the height of a ground plane (0.5). The Renderer draws it as a quad grid
+// per chunk that reads the cells from a texture, animating water from a time
+// uniform, so the floor needs no actors
+class GroundTilemap {
+public:
+  GroundTilemap();
+
+  // Empty grid drawn with the given atlas, materials back to their defaults
+  void Reset(int columns, int rows, TextureAtlas *atlas);
+  void Clear() { Reset(0, 0, nullptr); }
+
+  // Sets the cells of a MapReader rectangle, centered at (x, z) in world
+  // units and sizeX columns by sizeZ rows large
+  void Fill(float x, float z, int sizeX, int sizeZ, GroundKind kind,
+            int tileIndex = -1);
+
+  void SetMaterial(GroundKind kind, const GroundMaterial &material);
+  const GroundMaterial &GetMaterial(GroundKind kind) const {
+    return mMaterials[static_cast<int>(kind)];
+  }
+
+  // Height added to the lifted kinds, applied at draw time
+  void SetLift(float lift) { mLift = lift; }
+  float GetLift() const { return mLift; }
+
+  int GetColumns() const { return mColumns; }
+  int GetRows() const { return mRows; }
+  const std::vector<GroundCell> &GetCells() const { return mCells; }
+  TextureAtlas *GetAtlas() const { return mAtlas; }
+
+  // Cells or materials changed since the Renderer last built the tilemap
+  bool IsDirty() const { return mDirty; }
+  void ClearDirty() { mDirty = false; }
+
+private:
+  int mColumns;
+  int mRows;
+  std::vector<GroundCell> mCells; // Row major
+  TextureAtlas *mAtlas;
+  GroundMaterial mMaterials[static_cast<int>(GroundKind::Count)];
+  float mLift;
+  bool mDirty;
+};
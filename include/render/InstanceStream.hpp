@@ -0,0 +1,62 @@
+#pragma once
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+// Where a draw's instances were streamed
+struct InstanceRange {
+  unsigned int buffer;
+  size_t offset; // In bytes
+};
+
+// Ring buffer holding the per-frame instance data of every dynamic draw. Each
+// write gets its own range, so an upload never overwrites instances that a
+// queued draw still reads and the driver never has to stall or shadow-copy.
+//
+// With ARB_buffer_storage the buffer is persistently mapped and split into one
+// region per frame in flight, each fenced until the GPU is done with it.
+// Otherwise writes go through unsynchronized maps and the buffer is orphaned
+// when the ring wraps. A frame that outgrows the buffer moves to a larger one
+// (the old one is freed at the end of the frame), so there is no instance cap.
+class InstanceStream {
+public:
+  InstanceStream();
+  ~InstanceStream();
+
+  // frameBytes is the initial room for one frame's instances
+  bool Initialize(size_t frameBytes);
+  void Shutdown();
+
+  // Call before the first write of a frame and after the last draw of it
+  void BeginFrame();
+  void EndFrame();
+
+  InstanceRange Write(const void *data, size_t bytes);
+
+  bool IsPersistent() const { return mMapped != nullptr; }
+  size_t GetFrameBytes() const { return mFrameBytes; }
+
+private:
+  static constexpr int FRAMES_IN_FLIGHT = 3;
+
+  // Creates the buffer (one region per frame when persistent)
+  void Allocate(size_t frameBytes);
+  void Retire();
+  void WaitForFence(int frame);
+
+  bool mUsePersistent;
+  unsigned int mBuffer;
+  size_t mFrameBytes;
+  unsigned char *mMapped;
+
+  // Region written this frame (persistent), or the ring head (orphaning)
+  int mFrame;
+  size_t mHead;
+  size_t mFrameStart;
+  size_t mLastFrameSize;
+
+  GLsync mFences[FRAMES_IN_FLIGHT];
+
+  // Buffers outgrown this frame, deleted at its end
+  std::vector<unsigned int> mRetiredBuffers;
+};
@@ -2,7 +2,9 @@
 #define MESH_HPP
 
 #include "Math.hpp"
+#include "render/InstanceStream.hpp"
 #include <GL/glew.h>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -32,6 +34,50 @@ struct MeshData {
   std::vector<Triangle> triangles;
 };
 
+// Per-instance data (48 bytes). Base.vert rebuilds the model transform
+// (scale, then rotation, then translation) and rotates the normals by the
+// quaternion
+struct MeshInstance {
+  float position[3];
+  float scale[3];
+  int16_t rotation[4]; // Quaternion xyzw, normalized shorts
+  uint16_t color[4];   // Half floats, rgb and the bloomed flag
+  int32_t tileIndex;
+  int32_t layer; // Of the Renderer's texture array
+};
+
+// Per-instance data of a world sprite (40 bytes). Sprite.vert places the quad
+// at the view position of the sprite and scales and rotates it in the screen
+// plane
+struct SpriteInstance {
+  float position[3]; // World
+  float size[2];     // Signed, negative to flip
+  float rotation;    // Radians, around the view axis
+  uint16_t color[4]; // Half floats, rgb and the bloomed flag
+  int32_t tileIndex;
+  int32_t layer;
+};
+
+// Per-instance data of a HUD sprite (28 bytes), in normalized device
+// coordinates
+struct HUDInstance {
+  float rect[4];    // Center xy, size zw
+  uint16_t tint[4]; // Half floats, rgba
+  int32_t tileIndex; // -1 for the whole texture
+};
+
+// Vertex of a static chunk (48 bytes), already in world space. Baked.vert
+// passes it on as Base.vert would have: the UVs are scaled for the tile to
+// repeat and the tile index includes the face's
+struct BakedVertex {
+  float position[3];
+  float normal[3];
+  float texCoord[2];
+  uint16_t color[4]; // Half floats, rgb and the bloomed flag
+  int32_t tileIndex; // -1 for untextured meshes
+  int32_t layer;
+};
+
 class Mesh {
 public:
   Mesh();
@@ -46,36 +92,59 @@ public:
   // Activate this mesh for rendering
   void SetActive() const;
 
-  // Setup instance buffer with transform data
-  void SetupInstanceBuffer(size_t maxInstances);
+  // Activate this mesh with the instances streamed to a range of a buffer
+  void SetActive(const InstanceRange &instances) const;
+  // Same, for streamed SpriteInstances and HUDInstances
+  void SetActiveSprites(const InstanceRange &instances) const;
+  void SetActiveHUD(const InstanceRange &instances) const;
 
-  // Update instance buffer with new data
-  // Each instance needs: mat4 model (16 floats), mat4 normal (16 floats), vec3
-  // color (3 floats), float tileIndex (1 float) = 36 floats
-  void UpdateInstanceBuffer(const std::vector<float> &instanceData,
-                            size_t instanceCount);
+  // New vertex array drawing this mesh with the instances of another buffer
+  // (same layout as the mesh's own). The caller deletes it
+  unsigned int CreateInstanceArray(unsigned int instanceBuffer) const;
 
   // Get rendering info
   unsigned int GetNumIndices() const { return mNumIndices; }
   unsigned int GetNumVerts() const { return mNumVerts; }
-  size_t GetMaxInstances() const { return mMaxInstances; }
 
   // Get number of triangles
   size_t GetTriangleCount() const { return mTriangles.size(); }
 
+  // Model-space geometry, kept for baking static chunks. Each vertex has the
+  // texture index of the first triangle using it, as uploaded
+  const std::vector<Vertex> &GetVertices() const { return mVertices; }
+  const std::vector<int> &GetVertexTextureIndices() const {
+    return mVertexTextureIndices;
+  }
+  const std::vector<Triangle> &GetTriangles() const { return mTriangles; }
+
+  // Bounding box of the vertices in model space (center and half extents)
+  const Vector3 &GetBoundsCenter() const { return mBoundsCenter; }
+  const Vector3 &GetBoundsExtents() const { return mBoundsExtents; }
+
 protected:
+  // Attribute setup of the bound vertex array
+  void BindVertexAttributes() const;
+  static void BindInstanceAttributes(unsigned int instanceBuffer,
+                                     size_t offset = 0);
+  static void BindSpriteInstanceAttributes(unsigned int instanceBuffer,
+                                           size_t offset);
+  static void BindHUDInstanceAttributes(unsigned int instanceBuffer,
+                                        size_t offset);
+  void ComputeBounds(const std::vector<Vertex> &vertices);
+
   // OpenGL buffer objects
   unsigned int mVertexArray;
   unsigned int mVertexBuffer;
   unsigned int mIndexBuffer;
-  unsigned int mInstanceBuffer;
 
   // Mesh info
   unsigned int mNumVerts;
   unsigned int mNumIndices;
   std::vector<Triangle> mTriangles;
-
-  size_t mMaxInstances; // Maximum number of instances
+  std::vector<Vertex> mVertices;
+  std::vector<int> mVertexTextureIndices;
+  Vector3 mBoundsCenter;
+  Vector3 mBoundsExtents;
 };
 
 // Cube mesh class
@@ -0,0 +1,137 @@
+#pragma once
+#include "render/Frustum.hpp"
+#include "render/InstanceStream.hpp"
+#include "render/Mesh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class MeshComponent;
+class SpriteComponent;
+
+// Instances [first, first + count) of a buffer
+struct InstanceRun {
+  size_t first;
+  size_t count;
+};
+
+// Visible mesh components sharing a mesh and bloom state. Their atlases are
+// layers of the Renderer's texture array, picked per instance
+struct MeshBucket {
+  Mesh *mesh;
+  bool bloomed;
+  // Components of static actors. Their instances live in the bucket's own
+  // buffer and are only rebuilt and uploaded when they change
+  bool retained;
+  std::vector<MeshComponent *> components;
+
+  // Instances drawn this frame (filled by Renderer::PrepareBuckets), their
+  // world bounds and, unless retained, where they were streamed. Dynamic
+  // buckets only keep the instances inside the view frustum
+  std::vector<MeshInstance> instanceData;
+  BoundsArray bounds;
+  size_t instanceCount;
+  InstanceRange instances;
+
+  // Retained buckets: components in the order of their instances in the
+  // buffer, and the GL objects (owned by the Renderer)
+  std::vector<MeshComponent *> uploaded;
+  unsigned int instanceBuffer;
+  unsigned int vertexArray;
+  size_t capacity;
+  // Retained buckets: runs of the buffer inside the view frustum
+  std::vector<InstanceRun> visibleRuns;
+};
+
+// Visible sprite components sharing a bloom state and space. World sprites
+// pick their texture layer per instance, HUD sprites are drawn in runs of the
+// same texture
+struct SpriteBucket {
+  bool bloomed;
+  bool hud;
+  std::vector<SpriteComponent *> components;
+
+  // Instances inside the view frustum and their world bounds
+  std::vector<SpriteInstance> instanceData;
+  BoundsArray bounds;
+  size_t instanceCount;
+  InstanceRange instances;
+};
+
+// Side of the square XZ chunks static meshes are baked in, in world units
+constexpr float STATIC_CHUNK_SIZE = 16.0f;
+
+// Static meshes of one chunk and bloom state, merged into a single vertex
+// buffer in world space (see Renderer::BakeStaticGeometry). A visible chunk is
+// one draw, with nothing done per mesh
+struct StaticChunk {
+  int x;
+  int z;
+  bool bloomed;
+  std::vector<MeshComponent *> components;
+  // Components left or joined, the buffers are rebuilt before the next draw
+  bool dirty;
+  // Inside the view frustum this frame (set by Renderer::PrepareBuckets)
+  bool visible;
+
+  // World bounds of the baked vertices and the GL objects (owned by the
+  // Renderer)
+  Vector3 boundsCenter;
+  Vector3 boundsExtents;
+  unsigned int vertexArray;
+  unsigned int vertexBuffer;
+  unsigned int indexBuffer;
+  size_t indexCount;
+};
+
+// Persistent draw lists. A draw component is filed under the bucket of its
+// draw state when it is created and whenever that state changes (hidden
+// components are in no bucket), so a frame walks the buckets instead of
+// sorting every component again. The bucket and index are stored in the
+// component, like ActiveSet membership in the actor.
+class RenderBuckets {
+public:
+  ~RenderBuckets();
+
+  // Moves the component to the bucket of its current state
+  void Update(MeshComponent *mesh);
+  void Update(SpriteComponent *sprite);
+
+  void Remove(MeshComponent *mesh);
+  void Remove(SpriteComponent *sprite);
+
+  // Moves a mesh of a static actor to the static chunk holding position. It
+  // stays there until its draw state or transform changes, then Update files
+  // it back in a retained bucket
+  void Bake(MeshComponent *mesh, const Vector3 &position);
+
+  // Buckets are never freed, a scene only uses a few dozen of them
+  const std::vector<MeshBucket *> &GetMeshBuckets() const {
+    return mMeshBuckets;
+  }
+  const std::vector<SpriteBucket *> &GetSpriteBuckets() const {
+    return mSpriteBuckets;
+  }
+  // Chunks are kept too, emptied ones just have nothing to draw
+  const std::vector<StaticChunk *> &GetStaticChunks() const {
+    return mStaticChunks;
+  }
+
+private:
+  MeshBucket *GetMeshBucket(Mesh *mesh, bool bloomed, bool retained);
+  SpriteBucket *GetSpriteBucket(bool bloomed, bool hud);
+  StaticChunk *GetStaticChunk(int x, int z, bool bloomed);
+  // Takes a mesh out of its chunk, which is then rebaked
+  static void Unbake(MeshComponent *mesh);
+
+  template <typename T, typename Bucket>
+  static void File(T *component, Bucket *bucket);
+  template <typename T> static void Unfile(T *component);
+
+  std::vector<MeshBucket *> mMeshBuckets;
+  std::vector<SpriteBucket *> mSpriteBuckets;
+  std::vector<StaticChunk *> mStaticChunks;
+  // Chunks by coordinates, one map per bloom state
+  std::unordered_map<uint64_t, StaticChunk *> mStaticChunkMaps[2];
+};
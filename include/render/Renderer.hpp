@@ -2,6 +2,10 @@
 #include "../UI/HUDElement.hpp"
 #include "Math.hpp"
 #include "components/MeshComponent.hpp"
+#include "render/GPUTimer.hpp"
+#include "render/GroundTilemap.hpp"
+#include "render/InstanceStream.hpp"
+#include "render/RenderBuckets.hpp"
 #include "render/Shader.hpp"
 #include "components/SpriteComponent.hpp"
 #include "render/Texture.hpp"
@@ -33,52 +37,119 @@ public:
 
   // Atlas management
   TextureAtlas *LoadAtlas(const std::string &atlasPath);
+  // Glyphs of a font at a size, built on first use
+  class GlyphAtlas *LoadGlyphAtlas(const std::string &fontPath, int pointSize);
 
   // Drawing with texture atlas (legacy - single mesh)
   void DrawMesh(MeshComponent &mesh, RendererMode mode);
 
-  // Instanced drawing - draw multiple instances of the same mesh
-  void DrawMeshesInstanced(const std::vector<MeshComponent *> &meshes,
-                           RendererMode mode);
-
   // Drawing sprites (legacy - single sprite)
   void DrawSprite(SpriteComponent &sprite, RendererMode mode);
 
-  // Instanced sprite drawing - draw multiple sprites
-  void DrawSpritesInstanced(const std::vector<SpriteComponent *> &sprites,
-                            RendererMode mode);
-
-  // HUD sprite drawing - draw sprites in screen space (after framebuffer)
-  void DrawHUDSprites(const std::vector<SpriteComponent *> &hudSprites);
+  // Draw components filed by draw state (see RenderBuckets)
+  RenderBuckets &GetRenderBuckets() { return mRenderBuckets; }
+
+  // Build this frame's instances of every bucket, keeping the components of
+  // actors in the Game's active or static set. Call once per frame after the
+  // view matrix is set
+  void PrepareBuckets();
+
+  // Merges the meshes of static actors into one vertex buffer per chunk (see
+  // StaticChunk). Call once a scene is loaded: static meshes created or
+  // changed later are drawn from the retained buckets
+  void BakeStaticGeometry();
+
+  // The floor of the current level. Levels fill it while loading, it is
+  // rebuilt on the GPU before the next frame
+  GroundTilemap &GetGroundTilemap() { return mGroundTilemap; }
+
+  // Instanced drawing of the prepared world buckets with the given bloom state.
+  // Bloomed instances also write their color to the bloom target, the others
+  // write black there
+  void DrawMeshBuckets(bool bloomed, RendererMode mode);
+  void DrawSpriteBuckets(bool bloomed, RendererMode mode);
+
+  // HUD sprite drawing - draw sprites in screen space (after framebuffer).
+  // Each UI screen's sprites are kept drawn in a texture of their own, redrawn
+  // only when they change and otherwise composited as one quad
+  void DrawHUDSprites();
+
+  // HUD sprite draws issued last frame (none while the HUD is unchanged) and
+  // screen layers redrawn since the start
+  size_t GetHUDDrawCount() const { return mHUDDraws; }
+  size_t GetHUDRedrawCount() const { return mHUDRedraws; }
+
+  // Gathers the visible HUD sprites into the layers of their screens, in UI
+  // stack order, and marks the layers that have to be redrawn for a window of
+  // the given size: the ones whose screen was marked dirty, whose sprites
+  // were shown, hidden or reordered, or that were laid out for another size.
+  // Returns how many of them have sprites. Uses no GL, the bench checks it
+  size_t LayoutHUD(int windowWidth, int windowHeight);
+
+  // Static chunks with geometry, and the ones drawn last frame
+  size_t GetStaticChunkCount() const { return mStaticChunkCount; }
+  size_t GetStaticChunkDrawCount() const { return mStaticChunkDraws; }
+
+  // Instance bytes sent to the GPU this frame
+  size_t GetInstanceUploadBytes() const { return mInstanceUploadBytes; }
+
+  // Frustum culling of this frame's mesh and sprite instances
+  struct CullStats {
+    size_t tested = 0;
+    size_t culled = 0;
+    size_t drawn = 0;
+  };
+  const CullStats &GetMeshCullStats() const { return mMeshCullStats; }
+  const CullStats &GetSpriteCullStats() const { return mSpriteCullStats; }
+
+  // GPU time of each pass over its last frames, read back a frame late
+  GPUTimer::Stats GetGPUPassStats(GPUPass pass) const;
+  // Writes the pass times as CSV, false if the file can't be written
+  bool WriteGPUPassStats(const std::string &path) const;
+
+  // Program, texture, vertex array, framebuffer and raster state changes
+  // sent to GL last frame, and the redundant ones the state cache skipped
+  size_t GetStateCallCount() const { return mStateCalls; }
+  size_t GetSkippedStateCallCount() const { return mStateCallsSkipped; }
 
   // Batch rendering - set frame-level uniforms once before drawing multiple
   // objects
   void ActivateMeshShader();
   void ActivateSpriteShader();
-  void ActivateMeshShaderForBloom();   // Activate mesh shader for bloom pass
-  void ActivateSpriteShaderForBloom(); // Activate sprite shader for bloom pass
   void ActivateMeshShaderNoLighting(); // Activate mesh shader without lighting
   void
   ActivateSpriteShaderNoLighting(); // Activate sprite shader without lighting
 
-  // Draw a single mesh without instancing (for debug drawing)
+  // Debug wireframes: the raster state is set once around all of them
+  void BeginDebugDraw();
+  void EndDebugDraw();
+  // Draw a single mesh without instancing (between Begin/EndDebugDraw)
   void DrawSingleMesh(Mesh *mesh, const Vector3 &position, const Vector3 &scale,
                       const Quaternion &rotation = Quaternion::Identity);
 
   void SetViewMatrix(const Matrix4 &view);
   void SetProjectionMatrix(const Matrix4 &projection);
+  const Matrix4 &GetProjectionMatrix() const { return mProjectionMatrix; }
 
   void Clear();
+  // Ends the frame, after its last draw
   void Present();
 
   // Framebuffer rendering
-  void BeginFramebuffer(); // Start rendering to framebuffer
+  void BeginFramebuffer(); // Start rendering to the scene and bloom targets
   void EndFramebuffer();   // Render framebuffer to screen
 
   // Bloom rendering
-  void BeginBloomPass(); // Start rendering bloomed objects to bloom framebuffer
-  void EndBloomPass();   // Finish rendering to bloom framebuffer
-  void ApplyBloomBlur(); // Apply Gaussian blur to bloom texture
+  void ApplyBloomBlur(); // Blur the bloom texture down and up the mip chain
+
+  // Number of downsampled bloom levels (1/2, 1/4, ...). More levels give a
+  // wider glow for a few small passes
+  void SetBloomLevels(int levels);
+  int GetBloomLevels() const { return mBloomLevels; }
+
+  // Whether any bloomed instance is drawn this frame (set by PrepareBuckets).
+  // Without one the blur is skipped
+  bool HasBloom() const { return mHasBloom; }
 
   // Get framebuffer dimensions
   int GetFramebufferWidth() const { return mFramebufferWidth; }
@@ -99,8 +170,60 @@ private:
   void CreateSpriteQuad();  // Create a simple quad for sprite rendering
   void CreateFramebuffer(); // Create framebuffer for render-to-texture
   void CreateScreenQuad();  // Create fullscreen quad for framebuffer display
-  void CreateBloomFramebuffer(); // Create bloom framebuffer for bright objects
-  void CreateBlurTextures();     // Create textures for ping-pong blur
+  void CreateBloomMips();  // Create the downsampled bloom levels
+  void DestroyBloomMips();
+
+  // Write one instance and its world bounds
+  void WriteMeshInstance(MeshComponent *meshComp, MeshInstance &instance,
+                         Vector3 &boundsCenter, Vector3 &boundsExtents);
+  void WriteSpriteInstance(SpriteComponent *spriteComp,
+                           SpriteInstance &instance, Vector3 &boundsCenter,
+                           Vector3 &boundsExtents);
+
+  // Compacts the first count instances to the ones inside the frustum and
+  // returns how many are left
+  template <typename Instance>
+  size_t CullInstances(const Frustum &frustum, const BoundsArray &bounds,
+                       std::vector<Instance> &instances, size_t count,
+                       CullStats &stats);
+  // Finds the runs of a retained bucket's buffer inside the frustum
+  void CullRetainedBucket(MeshBucket *bucket, const Frustum &frustum);
+
+  // Copies a bucket's instances to the instance stream
+  template <typename Instance>
+  void StreamInstances(const Instance *instances, size_t instanceCount,
+                       InstanceRange &range);
+
+  // Rebuilds a chunk's buffers from its meshes, in world space
+  void BakeChunk(StaticChunk *chunk);
+  void DestroyChunkBuffers(StaticChunk *chunk);
+
+  // Uploads the ground tilemap's cells and rebuilds its quad grids
+  void BuildGroundTilemap();
+  void DestroyGroundBuffers();
+
+  // Frame-level uniforms shared by the mesh shaders, leaves shader active
+  void SetMeshFrameUniforms(Shader *shader, bool applyLighting);
+
+  // Rebuilds the dirty instances of a retained bucket and uploads what
+  // changed to its buffer
+  void PrepareRetainedBucket(MeshBucket *bucket, uint32_t stamp);
+  // Lays out the HUD, then packs and streams the instances of the layers that
+  // changed
+  void PrepareHUD();
+  struct HUDLayer;
+  // Layer of a screen's HUD sprites (null for sprites outside of a screen),
+  // added on first use
+  HUDLayer *GetHUDLayer(class UIScreen *screen);
+  // Sizes the layer's texture to the window, returns false if it is unusable
+  bool ResizeHUDLayer(HUDLayer *layer, int width, int height);
+  void DestroyHUDLayer(HUDLayer *layer);
+
+  // Layer of a texture (with its atlas grid, if any) in the texture array,
+  // added on first use. Layer 0 is blank, for untextured draws
+  int GetTextureLayer(int textureIndex, TextureAtlas *atlas);
+  // Copies the layers added since the last call into the texture array
+  void UpdateTextureArray();
 
   class Game *mGame;
   // Projection and view matrices
@@ -109,15 +232,31 @@ private:
 
   // Shaders
   Shader *mMeshShader;
+  Shader *mBakedShader;
+  Shader *mGroundShader;
   Shader *mSpriteShader;
   Shader *mFramebufferShader;
   Shader *mHUDShader;
-  Shader *mBloomBlurShader;
+  Shader *mBloomDownShader;
+  Shader *mBloomUpShader;
 
   // Textures
   std::vector<Texture *> mTextures;
   std::unordered_map<std::string, Texture *> mTextureCache;
 
+  // World meshes and sprites sample one GL_TEXTURE_2D_ARRAY holding every
+  // texture they use, so a pass binds it once and draws all atlases together.
+  // Layers are as large as the largest texture, smaller ones sit in the
+  // corner. Must match uLayerTiles in Mesh.frag and Sprite.frag
+  static constexpr int MAX_TEXTURE_LAYERS = 64;
+  struct TextureLayer {
+    int textureIndex;
+    TextureAtlas *atlas;
+  };
+  std::vector<TextureLayer> mTextureLayers;
+  GLuint mTextureArray;
+  size_t mTextureArrayLayers; // Layers copied to the array
+
   // Meshes
   std::unordered_map<std::string, Mesh *> mMeshCache;
 
@@ -127,6 +266,11 @@ private:
   // Screen quad for framebuffer rendering
   Mesh *mScreenQuad;
 
+  // Per-frame instances of the dynamic draws
+  InstanceStream *mInstanceStream;
+  // Pass times (see GetGPUPassStats)
+  GPUTimer *mGPUTimer;
+
   // Framebuffer objects
   GLuint mFramebuffer;
   GLuint mFramebufferTexture;
@@ -134,21 +278,25 @@ private:
   int mFramebufferWidth;
   int mFramebufferHeight;
 
-  // Bloom framebuffer objects
-  GLuint mBloomFramebuffer;
+  // Bloom target, the second color attachment of the framebuffer
   GLuint mBloomTexture;
-  GLuint mBloomDepthStencil;
-
-  // Blur textures for ping-pong blur
-  GLuint mBlurTexture1;
-  GLuint mBlurTexture2;
-  GLuint mBlurFramebuffer1;
-  GLuint mBlurFramebuffer2;
 
+  // Bloom blur chain, level i at 1 / 2^(i + 1) resolution
+  struct BloomMip {
+    GLuint texture;
+    GLuint framebuffer;
+    int width;
+    int height;
+  };
+  std::vector<BloomMip> mBloomMips;
+  int mBloomLevels;
+
+  bool mHasBloom;
   bool mIsDark;
 
   // Atlases
   std::unordered_map<std::string, TextureAtlas *> mAtlasCache;
+  std::unordered_map<std::string, class GlyphAtlas *> mGlyphAtlasCache;
 
   // Lighting
   Vector3 mLightDir;
@@ -160,4 +308,80 @@ private:
 
   // UI Components
   std::vector<HUDElement *> mUIComps;
+
+  RenderBuckets mRenderBuckets;
+  // Visible HUD sprites of this frame as gathered from the buckets, the set of
+  // the frame before and the same sprites in draw order (see LayoutHUD)
+  std::vector<SpriteComponent *> mHUDGathered;
+  std::vector<SpriteComponent *> mHUDLastGathered;
+  std::vector<SpriteComponent *> mHUDSprites;
+  // HUD instances in draw order, and the runs of them sharing a texture (one
+  // draw each)
+  struct HUDRun {
+    TextureAtlas *atlas;
+    int textureIndex;
+    size_t first;
+    size_t count;
+  };
+  // The HUD of one UI screen, drawn into its own texture. The sprites and
+  // window size it was laid out for are kept to tell when it has to be
+  // redrawn, only then are its instances packed again
+  struct HUDLayer {
+    class UIScreen *screen;
+    GLuint framebuffer;
+    GLuint texture;
+    int textureWidth;
+    int textureHeight;
+    int width;
+    int height;
+    std::vector<SpriteComponent *> sprites;
+    std::vector<SpriteComponent *> lastSprites;
+    std::vector<HUDInstance> instances;
+    std::vector<HUDRun> runs;
+    bool dirty;
+    InstanceRange range;
+  };
+  // HUD layers in UI stack order, and the fullscreen instance compositing them
+  std::vector<HUDLayer *> mHUDLayers;
+  InstanceRange mHUDCompositeRange;
+  size_t mHUDDraws;
+  size_t mHUDRedraws;
+  // Scratch lists of PrepareRetainedBucket
+  std::vector<MeshComponent *> mDrawnMeshes;
+  std::vector<size_t> mPatchedInstances;
+  size_t mInstanceUploadBytes;
+  // Scratch geometry of BakeChunk
+  std::vector<BakedVertex> mBakedVertices;
+  std::vector<unsigned int> mBakedIndices;
+  size_t mStaticChunkCount;
+  size_t mStaticChunkDraws;
+
+  // The ground tilemap: its cells as a tile-ID texture, and the quads of its
+  // non-empty cells in chunks of STATIC_CHUNK_SIZE, each a range of the
+  // shared index buffer
+  struct GroundChunk {
+    size_t firstIndex;
+    size_t indexCount;
+    Vector3 boundsCenter;
+    Vector3 boundsExtents;
+    // Whether it has cells drawn in the lit and in the bloomed pass
+    bool lit;
+    bool bloomed;
+    // Inside the view frustum this frame
+    bool visible;
+  };
+  GroundTilemap mGroundTilemap;
+  std::vector<GroundChunk> mGroundChunks;
+  GLuint mGroundCellTexture;
+  GLuint mGroundVertexArray;
+  GLuint mGroundVertexBuffer;
+  GLuint mGroundIndexBuffer;
+  int mGroundLayer;
+
+  CullStats mMeshCullStats;
+  CullStats mSpriteCullStats;
+  std::vector<uint8_t> mCullMask;
+
+  size_t mStateCalls;
+  size_t mStateCallsSkipped;
 };
@@ -1,7 +1,7 @@
 #pragma once
 #include <GL/glew.h>
 #include <string>
-#include <unordered_set>
+#include <unordered_map>
 #include "Math.hpp"
 
 class Shader
@@ -33,6 +33,10 @@ public:
     // Check if shader has a specific uniform
     bool HasUniform(const std::string& name) const;
 
+    // Location resolved at link time, -1 (ignored by the setters) if the
+    // program has no such uniform
+    GLint GetUniformLocation(const char* name) const;
+
 private:
 	// Tries to compile the specified shader
 	bool CompileShader(const std::string& fileName, GLenum shaderType, GLuint& outShader);
@@ -42,7 +46,7 @@ private:
 	// Tests whether vertex/fragment programs link
 	bool IsValidProgram() const;
 	
-	// Gather all active uniforms in the shader program
+	// Gather all active uniforms in the shader program and their locations
 	void GatherUniforms();
 
 	// Store the shader object IDs
@@ -50,6 +54,6 @@ private:
 	GLuint mFragShader;
 	GLuint mShaderProgram;
 	
-	// Set of uniform names that this shader uses
-	std::unordered_set<std::string> mUniforms;
+	// Locations of the uniforms this shader uses (each element of arrays)
+	std::unordered_map<std::string, GLint> mUniforms;
 };
@@ -21,6 +21,9 @@ public:
   // Load atlas metadata from JSON file (doesn't load the texture itself)
   bool Load(const std::string &jsonPath);
 
+  // Unnamed grid of equal tiles, for atlases built at runtime
+  void SetGrid(int atlasWidth, int atlasHeight, int tileWidth, int tileHeight);
+
   // Get tile index by name
   int GetTileIndex(const std::string &tileName) const;
 
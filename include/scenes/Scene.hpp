@@ -2,6 +2,7 @@
 #define SCENE_HPP
 
 #include "actors/Actor.hpp"
+#include "components/ColliderComponent.hpp"
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -23,7 +24,9 @@ public:
   };
 
   Scene(Game *game, Scene::SceneEnum sceneID)
-      : mGame(game), mSceneID(sceneID) {}
+      : mGame(game), mSceneID(sceneID) {
+    SetDefaultCollisionMasks();
+  }
   virtual ~Scene() {}
 
   virtual void Initialize() = 0;
@@ -39,12 +42,28 @@ public:
 
   SceneEnum GetSceneID() const { return mSceneID; }
 
+  // Layer pairs tested by Game::CheckCollisions, outside and during battles
+  const CollisionMask &GetCollisionMask(bool inBattle) const {
+    return inBattle ? mBattleMask : mExplorationMask;
+  }
+
 private:
+  // Disable the layer pairs whose OnCollision handlers ignore each other
+  void SetDefaultCollisionMasks();
+
   std::unordered_set<Actor *> mActors;
 
 protected:
+  // Empties the renderer's ground tilemap and sizes it to a terrain of
+  // columns x rows cells, drawn with the level's floor atlas
+  class GroundTilemap &ResetGround(unsigned columns, unsigned rows);
+
   Game *mGame;
   SceneEnum mSceneID;
+
+  // Scenes may adjust these in Initialize
+  CollisionMask mExplorationMask;
+  CollisionMask mBattleMask;
 };
 
 #endif
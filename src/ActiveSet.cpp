@@ -0,0 +1,31 @@
+#include "ActiveSet.hpp"
+#include "actors/Actor.hpp"
+
+void ActiveSet::Retain(Actor *actor) {
+  if (actor->mActiveRefs++ == 0) {
+    actor->mActiveIndex = static_cast<int>(mActors.size());
+    mActors.push_back(actor);
+  }
+}
+
+void ActiveSet::Release(Actor *actor) {
+  if (actor->mActiveRefs > 0 && --actor->mActiveRefs == 0) {
+    Erase(actor);
+  }
+}
+
+void ActiveSet::Remove(Actor *actor) {
+  if (actor->mActiveRefs > 0) {
+    actor->mActiveRefs = 0;
+    Erase(actor);
+  }
+}
+
+void ActiveSet::Erase(Actor *actor) {
+  // Swap with the last member and pop
+  Actor *last = mActors.back();
+  mActors[actor->mActiveIndex] = last;
+  last->mActiveIndex = actor->mActiveIndex;
+  mActors.pop_back();
+  actor->mActiveIndex = -1;
+}
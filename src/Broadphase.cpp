@@ -0,0 +1,108 @@
+#include "Broadphase.hpp"
+#include <algorithm>
+
+// Bounds are padded slightly so that touching colliders, which the
+// narrowphase treats as intersecting, are never culled by rounding
+const float BOUNDS_MARGIN = 0.001f;
+
+// Dynamic colliders get extra padding: collision responses move them during
+// the pass, and a push out of one collider can land them in a neighbour. A
+// larger push is caught by HasEscaped
+const float DYNAMIC_BOUNDS_MARGIN = 0.1f;
+
+const std::vector<std::pair<size_t, size_t>> &
+Broadphase::FindPairs(const std::vector<ColliderComponent *> &colliders,
+                      const CollisionMask &mask) {
+  mPairs.clear();
+
+  // Gather world bounds
+  mEntries.clear();
+  for (size_t i = 0; i < colliders.size(); i++) {
+    Entry entry;
+    colliders[i]->GetBounds(entry.min, entry.max);
+    entry.index = i;
+    entry.layer = colliders[i]->GetLayer();
+    entry.isStatic = colliders[i]->IsStatic();
+
+    float margin =
+        entry.isStatic ? BOUNDS_MARGIN : BOUNDS_MARGIN + DYNAMIC_BOUNDS_MARGIN;
+    entry.min -= Vector3(margin);
+    entry.max += Vector3(margin);
+    mEntries.push_back(entry);
+  }
+
+  std::sort(mEntries.begin(), mEntries.end(),
+            [](const Entry &a, const Entry &b) { return a.min.x < b.min.x; });
+  mEntryOf.resize(mEntries.size());
+  for (size_t i = 0; i < mEntries.size(); i++) {
+    mEntryOf[mEntries[i].index] = i;
+  }
+
+  // Sweep along X. Static and dynamic entries are kept in separate active
+  // lists: a static entry only needs to look at the dynamic ones
+  mActiveStatic.clear();
+  mActiveDynamic.clear();
+  for (const Entry &entry : mEntries) {
+    Prune(mActiveDynamic, entry.min.x);
+    for (const Entry *other : mActiveDynamic) {
+      if (mask.Collides(entry.layer, other->layer) &&
+          Overlaps(entry, *other)) {
+        mPairs.emplace_back(std::min(entry.index, other->index),
+                            std::max(entry.index, other->index));
+      }
+    }
+
+    if (entry.isStatic) {
+      mActiveStatic.push_back(&entry);
+      continue;
+    }
+
+    Prune(mActiveStatic, entry.min.x);
+    for (const Entry *other : mActiveStatic) {
+      if (mask.Collides(entry.layer, other->layer) &&
+          Overlaps(entry, *other)) {
+        mPairs.emplace_back(std::min(entry.index, other->index),
+                            std::max(entry.index, other->index));
+      }
+    }
+    mActiveDynamic.push_back(&entry);
+  }
+
+  // Collision responses move actors, so keep the all-pairs order
+  std::sort(mPairs.begin(), mPairs.end());
+
+  return mPairs;
+}
+
+bool Broadphase::HasEscaped(const std::vector<ColliderComponent *> &colliders,
+                            size_t i, size_t j) const {
+  return HasEscaped(colliders, i) || HasEscaped(colliders, j);
+}
+
+bool Broadphase::HasEscaped(const std::vector<ColliderComponent *> &colliders,
+                            size_t index) const {
+  const Entry &entry = mEntries[mEntryOf[index]];
+  if (entry.isStatic) {
+    return false;
+  }
+  Vector3 min, max;
+  colliders[index]->GetBounds(min, max);
+  return min.x < entry.min.x || min.y < entry.min.y || min.z < entry.min.z ||
+         max.x > entry.max.x || max.y > entry.max.y || max.z > entry.max.z;
+}
+
+void Broadphase::Prune(std::vector<const Entry *> &active, float minX) {
+  for (size_t i = 0; i < active.size();) {
+    if (active[i]->max.x < minX) {
+      active[i] = active.back();
+      active.pop_back();
+    } else {
+      i++;
+    }
+  }
+}
+
+bool Broadphase::Overlaps(const Entry &a, const Entry &b) {
+  return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y &&
+         b.min.y <= a.max.y && a.min.z <= b.max.z && b.min.z <= a.max.z;
+}
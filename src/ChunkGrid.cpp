@@ -1,11 +1,13 @@
 #include "ChunkGrid.hpp"
+#include "ActiveSet.hpp"
 #include "actors/Actor.hpp"
 #include <algorithm>
 #include <iostream>
 
 ChunkGrid::ChunkGrid(const Vector3 &worldMin, const Vector3 &worldMax,
                      float cellSize)
-    : mWorldMin(worldMin), mWorldMax(worldMax), mCellSize(cellSize) {
+    : mWorldMin(worldMin), mWorldMax(worldMax), mCellSize(cellSize),
+      mActiveSet(nullptr), mWindowGeneration(1) {
   // Calculate grid dimensions
   float worldWidth = worldMax.x - worldMin.x;
   float worldDepth = worldMax.z - worldMin.z;
@@ -38,8 +40,10 @@ ChunkGrid::~ChunkGrid() {
   // Clear all cells
   for (auto &cell : mCells) {
     cell.actors.clear();
+    cell.staticActors.clear();
   }
   mActorCellMap.clear();
+  mStaticActors.clear();
 }
 
 void ChunkGrid::RegisterActor(Actor *actor) {
@@ -60,8 +64,12 @@ void ChunkGrid::RegisterActor(Actor *actor) {
   }
 
   // Add to cell
-  mCells[cellIndex].actors.push_back(actor);
+  GetCellList(cellIndex, actor).push_back(actor);
   mActorCellMap[actor] = cellIndex;
+
+  if (mActiveSet && IsInWindow(cellIndex) && !IsStatic(actor)) {
+    mActiveSet->Retain(actor);
+  }
 }
 
 void ChunkGrid::UnregisterActor(Actor *actor) {
@@ -70,13 +78,14 @@ void ChunkGrid::UnregisterActor(Actor *actor) {
 
   auto it = mActorCellMap.find(actor);
   if (it == mActorCellMap.end()) {
+    mStaticActors.erase(actor);
     return; // Actor not in grid
   }
 
   int cellIndex = it->second;
 
   // Remove from cell
-  auto &cellActors = mCells[cellIndex].actors;
+  auto &cellActors = GetCellList(cellIndex, actor);
   auto actorIt = std::find(cellActors.begin(), cellActors.end(), actor);
   if (actorIt != cellActors.end()) {
     // Swap with last and pop for O(1) removal
@@ -84,8 +93,13 @@ void ChunkGrid::UnregisterActor(Actor *actor) {
     cellActors.pop_back();
   }
 
+  if (mActiveSet && IsInWindow(cellIndex) && !IsStatic(actor)) {
+    mActiveSet->Release(actor);
+  }
+
   // Remove from map
   mActorCellMap.erase(it);
+  mStaticActors.erase(actor);
 
   // std::cout << "Unregistered actor from cell " << cellIndex << std::endl;
 }
@@ -114,7 +128,7 @@ void ChunkGrid::UpdateActor(Actor *actor) {
   // Check if cell changed
   if (oldCellIndex != newCellIndex) {
     // Remove from old cell
-    auto &oldCellActors = mCells[oldCellIndex].actors;
+    auto &oldCellActors = GetCellList(oldCellIndex, actor);
     auto actorIt = std::find(oldCellActors.begin(), oldCellActors.end(), actor);
     if (actorIt != oldCellActors.end()) {
       std::iter_swap(actorIt, oldCellActors.end() - 1);
@@ -122,8 +136,19 @@ void ChunkGrid::UpdateActor(Actor *actor) {
     }
 
     // Add to new cell
-    mCells[newCellIndex].actors.push_back(actor);
-    mActorCellMap[actor] = newCellIndex;
+    GetCellList(newCellIndex, actor).push_back(actor);
+    it->second = newCellIndex;
+
+    // Crossing the window edge
+    bool wasInWindow = IsInWindow(oldCellIndex);
+    bool isInWindow = IsInWindow(newCellIndex);
+    if (mActiveSet && wasInWindow != isInWindow && !IsStatic(actor)) {
+      if (isInWindow) {
+        mActiveSet->Retain(actor);
+      } else {
+        mActiveSet->Release(actor);
+      }
+    }
   }
 }
 
@@ -183,10 +208,137 @@ std::vector<Actor *> ChunkGrid::GetVisibleActors(const Vector3 &cameraPos) {
   return visibleActors;
 }
 
+void ChunkGrid::SetStatic(Actor *actor, bool isStatic) {
+  if (!actor)
+    return;
+
+  if ((mStaticActors.find(actor) != mStaticActors.end()) == isStatic) {
+    return; // Already in that residency
+  }
+
+  // Move between the dynamic and static lists of its cell
+  auto it = mActorCellMap.find(actor);
+  if (it != mActorCellMap.end()) {
+    auto &cellActors = GetCellList(it->second, actor);
+    auto actorIt = std::find(cellActors.begin(), cellActors.end(), actor);
+    if (actorIt != cellActors.end()) {
+      std::iter_swap(actorIt, cellActors.end() - 1);
+      cellActors.pop_back();
+    }
+  }
+
+  if (isStatic) {
+    mStaticActors.insert(actor);
+  } else {
+    mStaticActors.erase(actor);
+  }
+
+  if (it != mActorCellMap.end()) {
+    GetCellList(it->second, actor).push_back(actor);
+
+    // Static actors are never active
+    if (mActiveSet && IsInWindow(it->second)) {
+      if (isStatic) {
+        mActiveSet->Release(actor);
+      } else {
+        mActiveSet->Retain(actor);
+      }
+    }
+  }
+}
+
+void ChunkGrid::SetActiveWindow(const Vector3 *centers, int count) {
+  // Stamp the new window cells. A cell stamped with the previous generation
+  // was already in the window, anything else enters it
+  uint32_t previous = mWindowGeneration++;
+  mNewWindowCells.clear();
+  for (int i = 0; i < count; i++) {
+    int camX, camZ;
+    GetCellCoords(centers[i], camX, camZ);
+
+    for (int dz = -1; dz <= 1; dz++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        int x = camX + dx;
+        int z = camZ + dz;
+        if (x < 0 || x >= mGridWidth || z < 0 || z >= mGridDepth) {
+          continue;
+        }
+
+        int cellIndex = CoordsToIndex(x, z);
+        Cell &cell = mCells[cellIndex];
+        if (cell.windowStamp == mWindowGeneration) {
+          continue; // Already in the window through another center
+        }
+        bool wasInWindow = cell.windowStamp == previous;
+        cell.windowStamp = mWindowGeneration;
+        mNewWindowCells.push_back(cellIndex);
+
+        if (mActiveSet && !wasInWindow) {
+          for (auto actor : cell.actors) {
+            mActiveSet->Retain(actor);
+          }
+        }
+      }
+    }
+  }
+
+  // Cells of the old window that weren't stamped again leave it
+  for (int cellIndex : mWindowCells) {
+    if (mActiveSet && mCells[cellIndex].windowStamp == previous) {
+      for (auto actor : mCells[cellIndex].actors) {
+        mActiveSet->Release(actor);
+      }
+    }
+  }
+
+  mWindowCells.swap(mNewWindowCells);
+}
+
+void ChunkGrid::GetStaticActors(const Vector3 *centers, int count, float radius,
+                                std::vector<Actor *> &outActors) {
+  // Cells overlapped by the square around each center, without repeats
+  mQueryCells.clear();
+  for (int i = 0; i < count; i++) {
+    const Vector3 &center = centers[i];
+    int minX, minZ, maxX, maxZ;
+    GetCellCoords(center - Vector3(radius, 0.0f, radius), minX, minZ);
+    GetCellCoords(center + Vector3(radius, 0.0f, radius), maxX, maxZ);
+    minX = std::max(minX, 0);
+    minZ = std::max(minZ, 0);
+    maxX = std::min(maxX, mGridWidth - 1);
+    maxZ = std::min(maxZ, mGridDepth - 1);
+
+    for (int z = minZ; z <= maxZ; z++) {
+      for (int x = minX; x <= maxX; x++) {
+        mQueryCells.push_back(CoordsToIndex(x, z));
+      }
+    }
+  }
+  std::sort(mQueryCells.begin(), mQueryCells.end());
+  mQueryCells.erase(std::unique(mQueryCells.begin(), mQueryCells.end()),
+                    mQueryCells.end());
+
+  // Each actor lives in a single cell, so no actor is reported twice
+  float radiusSq = radius * radius;
+  for (int cellIndex : mQueryCells) {
+    for (auto actor : mCells[cellIndex].staticActors) {
+      const Vector3 &pos = actor->GetPosition();
+      for (int i = 0; i < count; i++) {
+        float dx = pos.x - centers[i].x;
+        float dz = pos.z - centers[i].z;
+        if (dx * dx + dz * dz <= radiusSq) {
+          outActors.push_back(actor);
+          break;
+        }
+      }
+    }
+  }
+}
+
 int ChunkGrid::GetActiveCellCount() const {
   int count = 0;
   for (const auto &cell : mCells) {
-    if (!cell.actors.empty()) {
+    if (!cell.actors.empty() || !cell.staticActors.empty()) {
       count++;
     }
   }
@@ -231,3 +383,18 @@ void ChunkGrid::GetCellCoords(const Vector3 &position, int &outX,
 }
 
 int ChunkGrid::CoordsToIndex(int x, int z) const { return z * mGridWidth + x; }
+
+std::vector<Actor *> &ChunkGrid::GetCellList(int cellIndex, Actor *actor) {
+  if (IsStatic(actor)) {
+    return mCells[cellIndex].staticActors;
+  }
+  return mCells[cellIndex].actors;
+}
+
+bool ChunkGrid::IsStatic(Actor *actor) const {
+  return mStaticActors.find(actor) != mStaticActors.end();
+}
+
+bool ChunkGrid::IsInWindow(int cellIndex) const {
+  return mCells[cellIndex].windowStamp == mWindowGeneration;
+}
@@ -1,15 +1,20 @@
 #include "Game.hpp"
 #include "../include/UI/HUDElement.hpp"
 #include "AssetLoader.hpp"
+#include "Broadphase.hpp"
+#include "ActiveSet.hpp"
 #include "ChunkGrid.hpp"
+#include "JobSystem.hpp"
 #include "MIDI/MIDIPlayer.hpp"
 #include "MIDI/SynthEngine.hpp"
 #include "actors/Actor.hpp"
 #include "actors/Ghost.hpp"
 #include "actors/Human.hpp"
+#include "actors/NoteActor.hpp"
 #include "actors/Player.hpp"
 #include "actors/RobotA.hpp"
 #include "actors/SceneActors.hpp"
+#include "actors/ShineActor.hpp"
 #include "components/ColliderComponent.hpp"
 #include "components/DrawComponent.hpp"
 #include "components/MeshComponent.hpp"
@@ -41,17 +46,36 @@
 
 const int WINDOW_WIDTH = 800;
 const int WINDOW_HEIGHT = 600;
-const int FPS = 60;
-const int FRAME_TIME = 1000 / FPS;
+const int MAX_STEPS_PER_FRAME = 5; // Simulation steps before dropping time
+const double MAX_FRAME_TIME = 0.25; // Longer frames (stalls) are clamped
+const double SPIN_TIME_MS = 2.0; // Frame pacing spins for the last 2ms
 const float MIDI_UPDATE_INTERVAL = 0.001f; // Update MIDI every 1ms
 
+// Milliseconds elapsed since a SDL_GetPerformanceCounter() timestamp
+static double ElapsedMs(Uint64 start) {
+  return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 /
+         static_cast<double>(SDL_GetPerformanceFrequency());
+}
+
 Game::Game()
-    : mUpdatingActors(false), mWindow(nullptr), mGLContext(nullptr),
-      mRenderer(nullptr), mChunkGrid(nullptr), mCurrentScene(nullptr),
-      mPendingScene(nullptr), mTicksCount(0), mIsRunning(true),
+    : mUpdatingActors(false), mActiveSet(nullptr),
+      mStaticCullRadius(STATIC_CULL_RADIUS), mRenderStamp(0),
+      mWindow(nullptr), mGLContext(nullptr),
+      mRenderer(nullptr), mChunkGrid(nullptr), mBroadphase(nullptr),
+      mUseBroadphase(true), mCheckBroadphase(false), mJobSystem(nullptr), mUseParallelUpdate(true),
+      mUpdatingInParallel(false), mCurrentScene(nullptr),
+      mPendingScene(nullptr), mSimulationRate(SIMULATION_HZ),
+      mSimulationTime(0.0), mAccumulator(0.0), mSimulationStep(1),
+      mRenderAlpha(1.0f), mFramePacing(FramePacing::VSync),
+      mTargetFPS(TARGET_FPS), mFrameTimes{}, mFrameTimeCount(0),
+      mFrameTimeIndex(0), mLastReportCounter(0), mReportedHUDRedraws(0),
+      mTicksCount(0), mIsRunning(true),
       mIsDebugging(false), mPlayer(nullptr), mCamera(nullptr),
-      mBattleSystem(nullptr), mIsPaused(false) {
+      mBattleSystem(nullptr), mIsPaused(false), mIsHeadless(false) {
   mCamera = new Camera(this, Vector3::Zero);
+  mActiveSet = new ActiveSet();
+  mBroadphase = new Broadphase();
+  mJobSystem = new JobSystem();
 }
 
 bool Game::Initialize() {
@@ -100,11 +124,7 @@ bool Game::Initialize() {
     return false;
   }
 
-  // Enable adaptive VSync (allows tearing to prevent lag)
-  if (SDL_GL_SetSwapInterval(-1) < 0) {
-    // Fallback to regular VSync if adaptive is not supported
-    SDL_GL_SetSwapInterval(1);
-  }
+  SetFramePacing(mFramePacing, mTargetFPS);
 
   // Create renderer
   mRenderer = new Renderer(this);
@@ -114,11 +134,10 @@ bool Game::Initialize() {
     return false;
   }
 
-  mTicksCount = SDL_GetTicks();
-
   // Create Chunk grid
   mChunkGrid = new ChunkGrid(Vector3(-1000.0f, -1000.0f, -1000.0f),
                              Vector3(1000.0f, 1000.0f, 1000.0f), 48.0f);
+  mChunkGrid->SetActiveSet(mActiveSet);
 
   // Setting up SynthEngine
   SynthEngine::init();
@@ -144,6 +163,79 @@ bool Game::Initialize() {
   return true;
 }
 
+bool Game::InitializeHeadless() {
+  mIsHeadless = true;
+
+  // The renderer is still needed for mesh/atlas/texture lookups done by actor
+  // constructors; headless builds link a backend without GL calls
+  mRenderer = new Renderer(this);
+  if (!mRenderer->Initialize(static_cast<float>(WINDOW_WIDTH),
+                             static_cast<float>(WINDOW_HEIGHT))) {
+    std::cerr << "Failed to initialize renderer" << std::endl;
+    return false;
+  }
+
+  mTicksCount = 0;
+
+  // Create Chunk grid
+  mChunkGrid = new ChunkGrid(Vector3(-1000.0f, -1000.0f, -1000.0f),
+                             Vector3(1000.0f, 1000.0f, 1000.0f), 48.0f);
+  mChunkGrid->SetActiveSet(mActiveSet);
+
+  // No audio driver and no MIDI thread: MIDI is advanced by StepSimulation
+  SynthEngine::init();
+
+  return true;
+}
+
+void Game::StepSimulation(float deltaTime) {
+  BeginSimulationStep(deltaTime);
+
+  MIDIPlayer::update(deltaTime);
+  UpdateGame(deltaTime);
+}
+
+void Game::BeginSimulationStep(float deltaTime) {
+  // Keep the transforms at the start of the step, to interpolate from
+  mSimulationStep++;
+  for (auto actor : mActiveActors) {
+    actor->SnapshotTransform(mSimulationStep);
+  }
+  mCamera->SnapshotTransform();
+
+  mSimulationTime += deltaTime;
+  mTicksCount = static_cast<Uint32>(mSimulationTime * 1000.0);
+}
+
+void Game::SetSimulationRate(int hz) {
+  if (hz <= 0) {
+    std::cerr << "Invalid simulation rate: " << hz << std::endl;
+    return;
+  }
+  mSimulationRate = hz;
+}
+
+void Game::SetFramePacing(FramePacing pacing, int targetFPS) {
+  mFramePacing = pacing;
+  if (targetFPS > 0) {
+    mTargetFPS = targetFPS;
+  }
+
+  // Swap interval needs the GL context
+  if (!mGLContext) {
+    return;
+  }
+  if (pacing == FramePacing::VSync) {
+    // Adaptive VSync (allows tearing to prevent lag)
+    if (SDL_GL_SetSwapInterval(-1) < 0) {
+      // Fallback to regular VSync if adaptive is not supported
+      SDL_GL_SetSwapInterval(1);
+    }
+  } else {
+    SDL_GL_SetSwapInterval(0);
+  }
+}
+
 std::string Game::GetLevelAssetPath() const {
   if (!mCurrentScene) {
     return getAssetPath("sprites/level0/");
@@ -212,39 +304,154 @@ void Game::LoadScene(Scene *scene) {
     mCurrentScene = scene;
     mCurrentScene->Initialize();
 
+    // The level is in place, merge its static geometry
+    mRenderer->BakeStaticGeometry();
+
     // Rebuild active actors from new scene
     FindActiveActors();
   }
 }
 
 void Game::RunLoop() {
+  const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+  Uint64 lastFrameStart = SDL_GetPerformanceCounter();
+  mLastReportCounter = lastFrameStart;
+  mAccumulator = 0.0;
+
   while (mIsRunning) {
-    // Calculate actual elapsed time since last frame
-    Uint32 currentTicks = SDL_GetTicks();
-    float deltaTime = (currentTicks - mTicksCount) / 1000.0f;
-    mTicksCount = currentTicks;
-
-    // Cap deltaTime to prevent huge jumps (max 0.25 seconds)
-    if (deltaTime > 0.05f) {
-      deltaTime = 0.05f;
+    // Real time elapsed since the last frame started
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    double frameTime =
+        static_cast<double>(frameStart - lastFrameStart) / frequency;
+    lastFrameStart = frameStart;
+    RecordFrameTime(frameTime * 1000.0);
+
+    // Don't try to catch up after a stall (loading, window drag, ...)
+    mAccumulator += std::min(frameTime, MAX_FRAME_TIME);
+
+    // Window events once per frame, even when no step runs
+    ProcessEvents();
+
+    // Run the simulation in fixed steps. Key edges are taken per step, so a
+    // press is seen by one step only
+    const double stepTime = 1.0 / mSimulationRate;
+    int steps = 0;
+    while (mAccumulator >= stepTime && steps < MAX_STEPS_PER_FRAME) {
+      BeginSimulationStep(static_cast<float>(stepTime));
+      ProcessInput();
+      UpdateGame(static_cast<float>(stepTime));
+      mAccumulator -= stepTime;
+      steps++;
     }
 
-    // Update game with deltaTime
-    ProcessInput();
-    UpdateGame(deltaTime);
+    // Drop the time the simulation couldn't keep up with
+    if (mAccumulator >= stepTime) {
+      mAccumulator = std::fmod(mAccumulator, stepTime);
+    }
 
+    // Draw between the last two steps
+    mRenderAlpha = static_cast<float>(mAccumulator / stepTime);
     GenerateOutput();
 
-    // Frame rate limiting - delay to maintain 60 FPS
-    Uint32 frameTime = SDL_GetTicks() - currentTicks;
-    if (frameTime < FRAME_TIME) {
-      SDL_Delay(FRAME_TIME - frameTime);
+    WaitForFrameEnd(frameStart);
+  }
+}
+
+void Game::WaitForFrameEnd(Uint64 frameStart) {
+  if (mFramePacing != FramePacing::Fixed) {
+    return;
+  }
+
+  // SDL_Delay can oversleep by a scheduler tick, so sleep until close to the
+  // target and spin for the rest
+  const double targetMs = 1000.0 / mTargetFPS;
+  double remainingMs = targetMs - ElapsedMs(frameStart);
+  while (remainingMs > 0.0) {
+    if (remainingMs > SPIN_TIME_MS) {
+      SDL_Delay(static_cast<Uint32>(remainingMs - SPIN_TIME_MS));
     }
+    remainingMs = targetMs - ElapsedMs(frameStart);
+  }
+}
+
+void Game::RecordFrameTime(double frameMs) {
+  mFrameTimes[mFrameTimeIndex] = frameMs;
+  mFrameTimeIndex = (mFrameTimeIndex + 1) % FRAME_TIME_WINDOW;
+  mFrameTimeCount = std::min(mFrameTimeCount + 1, FRAME_TIME_WINDOW);
+
+  // Report once per second while debugging
+  double reportMs = ElapsedMs(mLastReportCounter);
+  if (!mIsDebugging || reportMs < 1000.0) {
+    return;
+  }
+  mLastReportCounter = SDL_GetPerformanceCounter();
+
+  FrameTimeStats stats = GetFrameTimeStats();
+  std::cout << "Frame " << stats.meanMs << " ms (min " << stats.minMs
+            << ", max " << stats.maxMs << ", jitter " << stats.jitterMs
+            << "), " << (stats.meanMs > 0.0 ? 1000.0 / stats.meanMs : 0.0)
+            << " FPS, " << mRenderer->GetInstanceUploadBytes() / 1024
+            << " KB instance upload" << std::endl;
+
+  const Renderer::CullStats &meshes = mRenderer->GetMeshCullStats();
+  const Renderer::CullStats &sprites = mRenderer->GetSpriteCullStats();
+  std::cout << "Culled " << meshes.culled << "/" << meshes.tested
+            << " meshes (" << meshes.drawn << " drawn), " << sprites.culled
+            << "/" << sprites.tested << " sprites (" << sprites.drawn
+            << " drawn), " << mRenderer->GetStateCallCount()
+            << " GL state calls (" << mRenderer->GetSkippedStateCallCount()
+            << " skipped), " << mRenderer->GetStaticChunkDrawCount() << "/"
+            << mRenderer->GetStaticChunkCount() << " static chunks drawn"
+            << std::endl;
+
+  // An unchanged HUD is only composited, it issues no sprite draws
+  size_t hudRedraws = mRenderer->GetHUDRedrawCount();
+  std::cout << (hudRedraws - mReportedHUDRedraws) * 1000.0 / reportMs
+            << " HUD redraws/s, " << mRenderer->GetHUDDrawCount()
+            << " HUD draws last frame" << std::endl;
+  mReportedHUDRedraws = hudRedraws;
+
+  // Mean GPU time of the passes that ran
+  std::cout << "GPU ms:";
+  for (int i = 0; i < static_cast<int>(GPUPass::Count); i++) {
+    GPUPass pass = static_cast<GPUPass>(i);
+    GPUTimer::Stats passStats = mRenderer->GetGPUPassStats(pass);
+    if (passStats.samples > 0) {
+      std::cout << " " << GetGPUPassName(pass) << " " << passStats.meanMs;
+    }
+  }
+  std::cout << std::endl;
+}
+
+Game::FrameTimeStats Game::GetFrameTimeStats() const {
+  FrameTimeStats stats;
+  stats.frames = mFrameTimeCount;
+  if (mFrameTimeCount == 0) {
+    return stats;
+  }
+
+  double sum = 0.0;
+  stats.minMs = mFrameTimes[0];
+  stats.maxMs = mFrameTimes[0];
+  for (int i = 0; i < mFrameTimeCount; i++) {
+    sum += mFrameTimes[i];
+    stats.minMs = std::min(stats.minMs, mFrameTimes[i]);
+    stats.maxMs = std::max(stats.maxMs, mFrameTimes[i]);
+  }
+  stats.meanMs = sum / mFrameTimeCount;
+
+  double variance = 0.0;
+  for (int i = 0; i < mFrameTimeCount; i++) {
+    double d = mFrameTimes[i] - stats.meanMs;
+    variance += d * d;
   }
+  stats.jitterMs = std::sqrt(variance / mFrameTimeCount);
+  return stats;
 }
 
 void Game::Shutdown() {
-  if (mBattleSystem && !mBattleSystem->IsInBattle() &&
+  // Headless runs must not overwrite the player's save
+  if (!mIsHeadless && mBattleSystem && !mBattleSystem->IsInBattle() &&
       (mCurrentScene->GetSceneID() == Scene::scene0 ||
        mCurrentScene->GetSceneID() == Scene::scene1 ||
        mCurrentScene->GetSceneID() == Scene::scene2 ||
@@ -277,6 +484,8 @@ void Game::Shutdown() {
     delete mActors.back();
   }
   mActors.clear();
+  NoteActor::GetPool().Clear();
+  ShineActor::GetPool().Clear();
   std::cout << "Shutdown: All actors deleted" << std::endl;
 
   // Delete Chunk grid
@@ -301,6 +510,15 @@ void Game::Shutdown() {
   // Delete camera
   delete mCamera;
 
+  delete mActiveSet;
+  mActiveSet = nullptr;
+
+  delete mBroadphase;
+  mBroadphase = nullptr;
+
+  delete mJobSystem;
+  mJobSystem = nullptr;
+
   std::cout << "Shutdown: Quitting SDL..." << std::endl;
   SDL_Quit();
   std::cout << "Shutdown: Complete!" << std::endl;
@@ -330,8 +548,11 @@ void Game::RemoveActor(Actor *actor) {
     mCurrentScene->UnregisterActor(actor);
   }
 
-  // Remove from always-active if present
+  // Remove from always-active if present, and from the active set
   mAlwaysActiveActors.erase(actor);
+  if (mActiveSet) {
+    mActiveSet->Remove(actor);
+  }
 
   // Check pending actors
   auto iter = std::find(mPendingActors.begin(), mPendingActors.end(), actor);
@@ -349,13 +570,29 @@ void Game::RemoveActor(Actor *actor) {
   }
 }
 
-void Game::AddAlwaysActive(Actor *actor) { mAlwaysActiveActors.insert(actor); }
+void Game::AddAlwaysActive(Actor *actor) {
+  if (mAlwaysActiveActors.insert(actor).second) {
+    mActiveSet->Retain(actor);
+  }
+
+  // An actor has a single residency
+  mChunkGrid->SetStatic(actor, false);
+  actor->SetStatic(false);
+}
 
 void Game::RemoveAlwaysActive(Actor *actor) {
-  mAlwaysActiveActors.erase(actor);
+  if (mAlwaysActiveActors.erase(actor) > 0) {
+    mActiveSet->Release(actor);
+  }
 }
 
-void Game::ProcessInput() {
+void Game::AddStaticActor(Actor *actor) {
+  RemoveAlwaysActive(actor);
+  mChunkGrid->SetStatic(actor, true);
+  actor->SetStatic(true);
+}
+
+void Game::ProcessEvents() {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
     switch (event.type) {
@@ -391,7 +628,9 @@ void Game::ProcessInput() {
       }
     }
   }
+}
 
+void Game::ProcessInput() {
   Input::Update();
 
   if (GetCurrentScene()->GetSceneID() != Scene::SceneEnum::scene4 &&
@@ -433,6 +672,31 @@ void Game::ProcessInput() {
     // LoadScene(new TestSceneB(this));
   }
 
+  if (Input::WasKeyPressed(SDL_SCANCODE_F2)) {
+    // Cycle frame pacing: VSync -> Fixed -> Uncapped
+    switch (mFramePacing) {
+    case FramePacing::VSync:
+      SetFramePacing(FramePacing::Fixed);
+      std::cout << "Frame pacing: fixed " << mTargetFPS << " FPS" << std::endl;
+      break;
+    case FramePacing::Fixed:
+      SetFramePacing(FramePacing::Uncapped);
+      std::cout << "Frame pacing: uncapped" << std::endl;
+      break;
+    case FramePacing::Uncapped:
+      SetFramePacing(FramePacing::VSync);
+      std::cout << "Frame pacing: vsync" << std::endl;
+      break;
+    }
+  }
+
+  if (Input::WasKeyPressed(SDL_SCANCODE_F4)) {
+    // Dump the GPU pass times of the last frames
+    if (mRenderer->WriteGPUPassStats("gpu_passes.csv")) {
+      std::cout << "GPU pass times written to gpu_passes.csv" << std::endl;
+    }
+  }
+
   if (Input::WasKeyPressed(SDL_SCANCODE_F1)) {
     mIsDebugging = !mIsDebugging;
 
@@ -473,7 +737,41 @@ void Game::UpdateActors(float deltaTime) {
     return;
   }
 
-  // Update player first if it exists
+  // Parallel phase: parallel actors and the leading parallel-safe components
+  // of the others, on the job system
+  Uint64 startParallel = SDL_GetPerformanceCounter();
+  auto updateRange = [this, deltaTime](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Actor *actor = mActiveActors[i];
+      if (actor->GetState() != ActorState::Destroy) {
+        actor->UpdateParallel(deltaTime);
+      }
+    }
+  };
+  mUpdatingInParallel = true;
+  if (mUseParallelUpdate) {
+    mJobSystem->ParallelFor(mActiveActors.size(), PARALLEL_UPDATE_GRAIN,
+                            updateRange);
+  } else {
+    updateRange(0, mActiveActors.size());
+  }
+  mUpdatingInParallel = false;
+
+  // Commit phase: apply what the parallel phase deferred
+  for (auto actor : mActiveActors) {
+    actor->CommitParallelUpdate();
+  }
+  std::vector<std::function<void()>> deferred;
+  {
+    std::lock_guard<std::mutex> lock(mDeferredMutex);
+    deferred.swap(mDeferredCommits);
+  }
+  for (auto &fn : deferred) {
+    fn();
+  }
+  mFrameStats.parallelUpdateMs = ElapsedMs(startParallel);
+
+  // Serial phase, update player first if it exists
   if (mPlayer && mPlayer->GetState() != ActorState::Destroy) {
     auto it = std::find(mActiveActors.begin(), mActiveActors.end(), mPlayer);
     if (it != mActiveActors.end()) {
@@ -510,49 +808,87 @@ void Game::UpdateActors(float deltaTime) {
   }
 
   for (auto actor : deadActors) {
-    delete actor;
+    if (!actor->Recycle()) {
+      delete actor;
+    }
   }
 
   FindActiveActors();
 }
 
+int Game::GetWorkerCount() const { return mJobSystem->GetWorkerCount(); }
+
+void Game::DeferCommit(std::function<void()> fn) {
+  if (!mUpdatingInParallel) {
+    fn();
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mDeferredMutex);
+  mDeferredCommits.push_back(std::move(fn));
+}
+
 void Game::FindActiveActors() {
-  // During battle transitions, use player position instead of camera position
-  // to ensure the game world around the player remains visible
-  Vector3 queryPosition = mCamera->GetPosition();
+  Uint64 startFind = SDL_GetPerformanceCounter();
 
-  std::vector<Actor *> visibleActors =
-      mChunkGrid->GetVisibleActors(queryPosition);
+  // During battle transitions, the window also covers the player position to
+  // ensure the game world around the player remains visible
+  Vector3 centers[2] = {mCamera->GetPosition(), Vector3::Zero};
 
+  // Only the cells entering or leaving the window update the active set
+  int windowCount = 1;
   if (mBattleSystem && mBattleSystem->IsTransitioning() && mPlayer) {
-    std::vector<Actor *> playerActors =
-        mChunkGrid->GetVisibleActors(mPlayer->GetPosition());
-    visibleActors.insert(visibleActors.end(), playerActors.begin(),
-                         playerActors.end());
+    centers[windowCount++] = mPlayer->GetPosition();
   }
+  mChunkGrid->SetActiveWindow(centers, windowCount);
 
-  // Filter out destroyed actors from chunk grid results
+  // Copy it, as actors may enter or leave it while it's iterated. Destroyed
+  // actors are still members until they are deleted
+  const std::vector<Actor *> &members = mActiveSet->GetActors();
   mActiveActors.clear();
-  std::unordered_set<Actor *> uniqueActors;
-  for (auto actor : visibleActors) {
-    if (actor->GetState() != ActorState::Destroy &&
-        uniqueActors.find(actor) == uniqueActors.end()) {
+  for (auto actor : members) {
+    if (actor->GetState() != ActorState::Destroy) {
       mActiveActors.push_back(actor);
-      uniqueActors.insert(actor);
     }
   }
 
-  // Add always-active actors (but avoid duplicates if they're already active)
-  // Also skip actors marked for destruction
-  std::unordered_set<Actor *> actorSet(mActiveActors.begin(),
-                                       mActiveActors.end());
-  for (auto actor : mAlwaysActiveActors) {
-    // Skip destroyed actors
-    if (actor->GetState() == ActorState::Destroy) {
-      continue;
-    }
-    if (actorSet.insert(actor).second) {
-      mActiveActors.push_back(actor);
+  // Static actors near the camera or the player
+  int staticCount = 1;
+  if (mPlayer) {
+    centers[staticCount++] = mPlayer->GetPosition();
+  }
+  mStaticActors.clear();
+  mChunkGrid->GetStaticActors(centers, staticCount, mStaticCullRadius,
+                              mStaticActors);
+  mStaticActors.erase(std::remove_if(mStaticActors.begin(),
+                                     mStaticActors.end(),
+                                     [](Actor *actor) {
+                                       return actor->GetState() ==
+                                              ActorState::Destroy;
+                                     }),
+                      mStaticActors.end());
+
+  GatherActiveComponents();
+
+  // May run more than once per frame (pause, scene changes)
+  mFrameStats.findActiveActorsMs += ElapsedMs(startFind);
+  mFrameStats.activeActors = mActiveActors.size();
+  mFrameStats.staticActors = mStaticActors.size();
+}
+
+void Game::GatherActiveComponents() {
+  mActiveColliders.clear();
+  mRenderStamp++;
+
+  for (auto actors : {&mActiveActors, &mStaticActors}) {
+    for (auto actor : *actors) {
+      // Draw components stay in the Renderer's buckets, the stamp selects
+      // the ones to draw
+      actor->SetRenderStamp(mRenderStamp);
+
+      // Collisions only use the first collider of each actor
+      if (auto collider = actor->GetComponent<ColliderComponent>()) {
+        mActiveColliders.push_back(collider);
+      }
     }
   }
 }
@@ -582,20 +918,33 @@ void Game::UpdateGame(float deltaTime) {
     mPendingScene = nullptr;
 
     mCurrentScene->Initialize();
+    mRenderer->BakeStaticGeometry();
 
     // Rebuild active actors from new scene
     FindActiveActors();
+
+    // Don't interpolate the camera from the previous scene
+    mCamera->SnapshotTransform();
   }
 
   mUpdatingActors = true;
 
+  mFrameStats.updateActorsMs = 0.0;
+  mFrameStats.findActiveActorsMs = 0.0;
+  mFrameStats.parallelUpdateMs = 0.0;
+
+  Uint64 startUpdate = SDL_GetPerformanceCounter();
   UpdateActors(deltaTime);
+  mFrameStats.updateActorsMs =
+      ElapsedMs(startUpdate) - mFrameStats.findActiveActorsMs;
 
   // Update Camera after updating actors, as they can request camera movements
   mCamera->Update(deltaTime);
 
   // Check collisions after all actors have been updated
+  Uint64 startCollisions = SDL_GetPerformanceCounter();
   CheckCollisions();
+  mFrameStats.collisionsMs = ElapsedMs(startCollisions);
 
   mUpdatingActors = false;
 }
@@ -603,199 +952,183 @@ void Game::UpdateGame(float deltaTime) {
 void Game::CheckCollisions() {
   // Get visible actors from chunk grid
 
-  // Collect all colliders from active actors
-  std::vector<ColliderComponent *> colliders;
-  for (auto actor : mActiveActors) {
-    auto collider = actor->GetComponent<ColliderComponent>();
-    if (collider) {
-      colliders.push_back(collider);
-    }
+  // Colliders of the active and nearby static actors
+  const std::vector<ColliderComponent *> &colliders = mActiveColliders;
+  mFrameStats.colliders = colliders.size();
+  mFrameStats.narrowphaseTests = 0;
+  mFrameStats.collisionCallbacks = 0;
+  mFrameStats.missedCollisionPairs = 0;
+
+  // Layer pairs that never interact in this scene and battle state are
+  // rejected before any geometry test
+  static const CollisionMask allLayers;
+  bool inBattle = mBattleSystem && mBattleSystem->IsInBattle();
+  const CollisionMask &mask =
+      mCurrentScene ? mCurrentScene->GetCollisionMask(inBattle) : allLayers;
+
+  if (mCheckBroadphase) {
+    CheckBroadphasePairs(colliders, mask);
+    return;
+  }
+  if (!mUseBroadphase) {
+    CheckAllPairs(colliders, mask, 0, 1);
+    return;
   }
 
-  // Check collisions between all pairs
-  for (size_t i = 0; i < colliders.size(); i++) {
-    for (size_t j = i + 1; j < colliders.size(); j++) {
-      ColliderComponent *colliderA = colliders[i];
-      ColliderComponent *colliderB = colliders[j];
-
-      // Check if they intersect
-      if (colliderA->Intersect(*colliderB)) {
-        // Get penetration vector for A (how much to push A out of B)
-        Vector3 penetrationA = colliderA->DetectCollision(*colliderB);
-
-        // Determine who gets pushed based on static flags
-        bool aIsStatic = colliderA->IsStatic();
-        bool bIsStatic = colliderB->IsStatic();
-
-        if (!aIsStatic && !bIsStatic) {
-          // Both dynamic - split the penetration
-          colliderA->GetOwner()->OnCollision(penetrationA * 0.5f, colliderB);
-          colliderB->GetOwner()->OnCollision(penetrationA * -0.5f, colliderA);
-        } else if (!aIsStatic && bIsStatic) {
-          // A is dynamic, B is static - only push A
-          colliderA->GetOwner()->OnCollision(penetrationA, colliderB);
-        } else if (aIsStatic && !bIsStatic) {
-          // A is static, B is dynamic - only push B
-          colliderB->GetOwner()->OnCollision(penetrationA * -1.0f, colliderA);
-        }
-        // else: both static - no response needed
-      }
+  // Only pairs with overlapping bounds (and never static-static) reach the
+  // narrowphase. A response that pushes a collider out of its padded bounds
+  // may have made pairs the sweep did not report, the rest of the pass then
+  // runs in all-pairs order so the callbacks stay the same
+  for (const auto &pair : mBroadphase->FindPairs(colliders, mask)) {
+    if (ResolvePair(colliders, pair.first, pair.second) &&
+        mBroadphase->HasEscaped(colliders, pair.first, pair.second)) {
+      CheckAllPairs(colliders, mask, pair.first, pair.second + 1);
+      return;
     }
   }
 }
 
-void Game::GenerateOutput() {
-  static Uint32 lastTime = SDL_GetTicks();
-  static int frameCount = 0;
-  Uint32 startFrame = SDL_GetTicks();
-
-  RendererMode mode =
-      mIsDebugging ? RendererMode::LINES : RendererMode::TRIANGLES;
-
-  // Get visible actors from chunk grid
-  // std::vector<Actor*> mActiveActors =
-  // mChunkGrid->GetVisibleActors(mCameraPos);
-
-  // Collect meshes and sprites from active actors
-  std::vector<MeshComponent *> activeMeshes;
-  std::vector<MeshComponent *> bloomedMeshes;
-  std::vector<MeshComponent *> nonBloomedMeshes;
-  std::vector<SpriteComponent *> activeSprites;
-  std::vector<SpriteComponent *> worldSprites;
-  std::vector<SpriteComponent *> bloomedSprites;
-  std::vector<SpriteComponent *> nonBloomedSprites;
-  std::vector<SpriteComponent *> hudSprites;
-  bool hasBloom = false;
+bool Game::ResolvePair(const std::vector<ColliderComponent *> &colliders,
+                       size_t i, size_t j) {
+  size_t callbacks = mFrameStats.collisionCallbacks;
+  ResolveCollision(colliders[i], colliders[j]);
+  return mFrameStats.collisionCallbacks != callbacks;
+}
 
-  for (auto actor : mActiveActors) {
-    auto &components = actor->GetComponents();
-    for (auto component : components) {
-      if (auto mesh = dynamic_cast<MeshComponent *>(component)) {
-        if (mesh->IsVisible()) {
-          activeMeshes.push_back(mesh);
-          if (mesh->IsBloomed()) {
-            bloomedMeshes.push_back(mesh);
-            hasBloom = true;
-          } else {
-            nonBloomedMeshes.push_back(mesh);
-          }
-        }
-      } else if (auto sprite = dynamic_cast<SpriteComponent *>(component)) {
-        if (sprite->IsVisible()) {
-          activeSprites.push_back(sprite);
-
-          // Separate world from HUD sprites
-          if (sprite->IsHUD()) {
-            hudSprites.push_back(sprite);
-          } else {
-            worldSprites.push_back(sprite);
-            if (sprite->IsBloomed()) {
-              bloomedSprites.push_back(sprite);
-              hasBloom = true;
-            } else {
-              nonBloomedSprites.push_back(sprite);
-            }
-          }
-        }
+void Game::CheckAllPairs(const std::vector<ColliderComponent *> &colliders,
+                         const CollisionMask &mask, size_t i, size_t j) {
+  for (; i < colliders.size(); i++, j = i + 1) {
+    for (; j < colliders.size(); j++) {
+      if (!mask.Collides(colliders[i]->GetLayer(),
+                         colliders[j]->GetLayer())) {
+        continue;
       }
+      ResolvePair(colliders, i, j);
     }
   }
+}
 
-  // BLOOM PASS: Render ALL objects to bloom framebuffer
-  // Bloomed objects render normally, non-bloomed objects render as black for
-  // occlusion
-  mRenderer->BeginBloomPass();
-
-  // Temporarily mark non-bloomed objects with negative color to render them
-  // black
-  std::vector<Vector3> originalMeshColors;
-  std::vector<Vector3> originalSpriteColors;
-
-  // Save original colors and mark non-bloomed meshes
-  for (auto *mesh : activeMeshes) {
-    originalMeshColors.push_back(mesh->GetColor());
-    if (!mesh->IsBloomed()) {
-      mesh->SetColor(
-          Vector3(-1.0f, -1.0f, -1.0f)); // Negative = black in bloom pass
+void Game::CheckBroadphasePairs(
+    const std::vector<ColliderComponent *> &colliders,
+    const CollisionMask &mask) {
+  // Pairs without OnCollision calls change nothing, so the broadphase path
+  // matches this loop as long as it resolves every pair that got calls. It
+  // resolves its sorted pairs, and every pair after a collider escaped
+  const auto &pairs = mBroadphase->FindPairs(colliders, mask);
+  size_t next = 0;
+  bool escaped = false;
+  for (size_t i = 0; i < colliders.size(); i++) {
+    for (size_t j = i + 1; j < colliders.size(); j++) {
+      if (!mask.Collides(colliders[i]->GetLayer(),
+                         colliders[j]->GetLayer())) {
+        continue;
+      }
+      std::pair<size_t, size_t> pair(i, j);
+      while (next < pairs.size() && pairs[next] < pair) {
+        next++;
+      }
+      bool reported = escaped || (next < pairs.size() && pairs[next] == pair);
+      if (!ResolvePair(colliders, i, j)) {
+        continue;
+      }
+      if (!reported) {
+        mFrameStats.missedCollisionPairs++;
+      }
+      escaped = escaped || mBroadphase->HasEscaped(colliders, i, j);
     }
   }
+}
 
-  // Save sprite colors and mark non-bloomed sprites
-  for (auto *sprite : worldSprites) {
-    originalSpriteColors.push_back(sprite->GetColor());
-    if (!sprite->IsBloomed()) {
-      sprite->SetColor(
-          Vector3(-1.0f, -1.0f, -1.0f)); // Negative = black in bloom pass
-    }
+void Game::ResolveCollision(ColliderComponent *colliderA,
+                            ColliderComponent *colliderB) {
+  // Both static - no response needed
+  if (colliderA->IsStatic() && colliderB->IsStatic()) {
+    return;
   }
 
-  // Render ALL meshes (bloomed and non-bloomed for occlusion)
-  if (!activeMeshes.empty()) {
-    mRenderer->ActivateMeshShaderForBloom();
-    mRenderer->DrawMeshesInstanced(activeMeshes, mode);
+  // Check if they intersect
+  mFrameStats.narrowphaseTests++;
+  if (!colliderA->Intersect(*colliderB)) {
+    return;
   }
 
-  // Render ALL world sprites (bloomed and non-bloomed for occlusion)
-  if (!worldSprites.empty()) {
-    mRenderer->ActivateSpriteShaderForBloom();
-    mRenderer->DrawSpritesInstanced(worldSprites, mode);
-  }
+  // Get penetration vector for A (how much to push A out of B)
+  Vector3 penetrationA = colliderA->DetectCollision(*colliderB);
 
-  // Restore original colors
-  for (size_t i = 0; i < activeMeshes.size(); ++i) {
-    activeMeshes[i]->SetColor(originalMeshColors[i]);
-  }
+  // Determine who gets pushed based on static flags
+  bool aIsStatic = colliderA->IsStatic();
+  bool bIsStatic = colliderB->IsStatic();
 
-  for (size_t i = 0; i < worldSprites.size(); ++i) {
-    worldSprites[i]->SetColor(originalSpriteColors[i]);
+  if (!aIsStatic && !bIsStatic) {
+    // Both dynamic - split the penetration
+    colliderA->GetOwner()->OnCollision(penetrationA * 0.5f, colliderB);
+    colliderB->GetOwner()->OnCollision(penetrationA * -0.5f, colliderA);
+    mFrameStats.collisionCallbacks += 2;
+  } else if (!aIsStatic && bIsStatic) {
+    // A is dynamic, B is static - only push A
+    colliderA->GetOwner()->OnCollision(penetrationA, colliderB);
+    mFrameStats.collisionCallbacks++;
+  } else {
+    // A is static, B is dynamic - only push B
+    colliderB->GetOwner()->OnCollision(penetrationA * -1.0f, colliderA);
+    mFrameStats.collisionCallbacks++;
   }
+}
 
-  mRenderer->EndBloomPass();
+void Game::GenerateOutput() {
+  RendererMode mode =
+      mIsDebugging ? RendererMode::LINES : RendererMode::TRIANGLES;
 
-  // Apply Gaussian blur to bloom texture
-  mRenderer->ApplyBloomBlur();
+  // The camera is drawn between the last two simulation steps, as actors are
+  mCamera->UpdateViewMatrix(mRenderAlpha);
+
+  // Build the instances of the active and static actors' draw components
+  mRenderer->PrepareBuckets();
 
-  // Begin rendering to main framebuffer
+  // Begin rendering to main framebuffer. Every draw also writes the bloom
+  // target: bloomed objects render normally there, non-bloomed objects render
+  // as black for occlusion (flagged per instance)
   mRenderer->BeginFramebuffer();
 
   // Render non-bloomed meshes with lighting
-  if (!nonBloomedMeshes.empty()) {
-    mRenderer->ActivateMeshShader();
-    mRenderer->DrawMeshesInstanced(nonBloomedMeshes, mode);
-  }
+  mRenderer->ActivateMeshShader();
+  mRenderer->DrawMeshBuckets(false, mode);
 
   // Render bloomed meshes without lighting
-  if (!bloomedMeshes.empty()) {
-    mRenderer->ActivateMeshShaderNoLighting();
-    mRenderer->DrawMeshesInstanced(bloomedMeshes, mode);
-  }
+  mRenderer->ActivateMeshShaderNoLighting();
+  mRenderer->DrawMeshBuckets(true, mode);
 
   if (mIsDebugging) {
-    for (auto actor : mActiveActors) {
-      auto &components = actor->GetComponents();
-      for (auto component : components) {
-        component->DebugDraw(mRenderer);
+    mRenderer->BeginDebugDraw();
+    for (auto actors : {&mActiveActors, &mStaticActors}) {
+      for (auto actor : *actors) {
+        auto &components = actor->GetComponents();
+        for (auto component : components) {
+          component->DebugDraw(mRenderer);
+        }
       }
     }
+    mRenderer->EndDebugDraw();
   }
 
   // Render non-bloomed sprites with lighting
-  if (!nonBloomedSprites.empty()) {
-    mRenderer->ActivateSpriteShader();
-    mRenderer->DrawSpritesInstanced(nonBloomedSprites, mode);
-  }
+  mRenderer->ActivateSpriteShader();
+  mRenderer->DrawSpriteBuckets(false, mode);
 
   // Render bloomed sprites without lighting
-  if (!bloomedSprites.empty()) {
-    mRenderer->ActivateSpriteShaderNoLighting();
-    mRenderer->DrawSpritesInstanced(bloomedSprites, mode);
-  }
+  mRenderer->ActivateSpriteShaderNoLighting();
+  mRenderer->DrawSpriteBuckets(true, mode);
+
+  // Apply Gaussian blur to bloom texture (skipped when nothing is bloomed)
+  mRenderer->ApplyBloomBlur();
 
   // End framebuffer rendering and display to screen
   mRenderer->EndFramebuffer();
 
   // Draw HUD sprites in screen space (after framebuffer)
-  mRenderer->DrawHUDSprites(hudSprites);
+  mRenderer->DrawHUDSprites();
+
+  mRenderer->Present();
 
   // Only swap if the window has a valid drawable size (not minimized)
   if (mWindow) {
@@ -0,0 +1,119 @@
+#include "JobSystem.hpp"
+
+JobSystem::JobSystem(int workerCount)
+    : mQueuedJobs(0), mUnfinishedJobs(0), mQuit(false) {
+  if (workerCount < 0) {
+    int threads = static_cast<int>(std::thread::hardware_concurrency());
+    workerCount = threads > 1 ? threads - 1 : 0;
+  }
+
+  for (int i = 0; i <= workerCount; i++) {
+    mQueues.emplace_back(new JobQueue());
+  }
+  for (int i = 0; i < workerCount; i++) {
+    mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i + 1);
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(mWakeMutex);
+    mQuit = true;
+  }
+  mWake.notify_all();
+
+  for (auto &worker : mWorkers) {
+    worker.join();
+  }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize,
+                            const std::function<void(size_t, size_t)> &fn) {
+  if (count == 0) {
+    return;
+  }
+  if (grainSize == 0) {
+    grainSize = 1;
+  }
+  if (mWorkers.empty() || count <= grainSize) {
+    fn(0, count);
+    return;
+  }
+
+  // Deal the ranges round-robin over all the queues
+  int jobCount = static_cast<int>((count + grainSize - 1) / grainSize);
+  mUnfinishedJobs.store(jobCount);
+  for (int i = 0; i < jobCount; i++) {
+    size_t begin = static_cast<size_t>(i) * grainSize;
+    size_t end = begin + grainSize < count ? begin + grainSize : count;
+
+    JobQueue &queue = *mQueues[i % mQueues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back({&fn, begin, end});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mWakeMutex);
+    mQueuedJobs.fetch_add(jobCount);
+  }
+  mWake.notify_all();
+
+  // Help until every job has been taken, then wait for the last ones
+  Job job;
+  while (mUnfinishedJobs.load(std::memory_order_acquire) > 0) {
+    if (TakeJob(0, job)) {
+      RunJob(job);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::WorkerLoop(size_t queueIndex) {
+  Job job;
+  while (true) {
+    if (TakeJob(queueIndex, job)) {
+      RunJob(job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mWakeMutex);
+    mWake.wait(lock, [this] { return mQuit || mQueuedJobs.load() > 0; });
+    if (mQuit) {
+      return;
+    }
+  }
+}
+
+bool JobSystem::TakeJob(size_t queueIndex, Job &job) {
+  // Own queue first, newest job (its data is the most likely to be cached)
+  {
+    JobQueue &queue = *mQueues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = queue.jobs.back();
+      queue.jobs.pop_back();
+      mQueuedJobs.fetch_sub(1);
+      return true;
+    }
+  }
+
+  // Steal the oldest job of the next non-empty queue
+  for (size_t i = 1; i < mQueues.size(); i++) {
+    JobQueue &queue = *mQueues[(queueIndex + i) % mQueues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.jobs.empty()) {
+      job = queue.jobs.front();
+      queue.jobs.pop_front();
+      mQueuedJobs.fetch_sub(1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void JobSystem::RunJob(const Job &job) {
+  (*job.fn)(job.begin, job.end);
+  mUnfinishedJobs.fetch_sub(1, std::memory_order_release);
+}
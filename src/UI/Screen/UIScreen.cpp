@@ -9,7 +9,8 @@
 #include "render/Renderer.hpp"
 
 UIScreen::UIScreen(class Game *game, const std::string &fontName)
-    : mGame(game), mState(UIState::Active), mSelectedButton(-1) {
+    : mGame(game), mState(UIState::Active), mSelectedButton(-1),
+      mHUDDirty(true) {
   mGame->PushUI(this);
   SDL_Log("UIScreen::UIScreen - Added UI to the Game UI Stack");
 }
@@ -39,6 +40,7 @@ UIButton *UIScreen::AddButton(const std::string &hudTexturePath,
                               const std::string &hudAtlasPath,
                               std::function<void()> onClick) {
   auto hB = new UIButton(mGame, onClick, hudTexturePath, hudAtlasPath);
+  hB->GetSpriteComponent().SetScreen(this);
   mHudButtons.emplace_back(hB);
 
   if (mHudButtons.size() == 1) {
@@ -52,6 +54,7 @@ UIButton *UIScreen::AddButton(const std::string &hudTexturePath,
 UIButton *UIScreen::AddButton(const std::string &singleImagePath,
                               std::function<void()> onClick) {
   auto hB = new UIButton(mGame, onClick, singleImagePath);
+  hB->GetSpriteComponent().SetScreen(this);
   mHudButtons.emplace_back(hB);
 
   if (mHudButtons.size() == 1) {
@@ -2,11 +2,18 @@
 #include "ChunkGrid.hpp"
 #include "Game.hpp"
 #include "components/Component.hpp"
+#include "components/DrawComponent.hpp"
+#include "components/MeshComponent.hpp"
 #include <algorithm>
 
 Actor::Actor(Game *game)
     : mGame(game), mState(ActorState::Active), mPosition(Vector3::Zero),
-      mScale(1.0f), mRotation(Quaternion::Identity) {
+      mScale(1.0f), mRotation(Quaternion::Identity),
+      mPrevPosition(Vector3::Zero), mPrevScale(1.0f),
+      mPrevRotation(Quaternion::Identity), mSnapshotStep(0),
+      mRenderStamp(0), mFirstComponents{}, mActiveIndex(-1), mActiveRefs(0),
+      mIsStatic(false), mParallelUpdate(false), mParallelComponents(0),
+      mParallelDone(false), mChunkUpdatePending(false) {
   // Game handles all registration (renderer, chunk grid, etc.)
   mGame->AddActor(this);
 }
@@ -27,12 +34,40 @@ Actor::~Actor() {
   }
 }
 
+void Actor::UpdateParallel(float deltaTime) {
+  if (mState != ActorState::Active) {
+    return;
+  }
+
+  // Parallel actors update everything here, others only the leading
+  // parallel-safe components, so each actor keeps its update order
+  size_t count = 0;
+  while (count < mComponents.size() &&
+         (mParallelUpdate || mComponents[count]->IsParallelUpdate())) {
+    if (mComponents[count]->IsEnabled()) {
+      mComponents[count]->Update(deltaTime);
+    }
+    count++;
+  }
+
+  if (mParallelUpdate) {
+    OnUpdate(deltaTime);
+  }
+
+  mParallelComponents = count;
+  mParallelDone = true;
+}
+
 void Actor::Update(float deltaTime) {
-  if (mState == ActorState::Active) {
+  size_t first = mParallelDone ? mParallelComponents : 0;
+  bool skip = mParallelDone && mParallelUpdate;
+  mParallelDone = false;
+
+  if (mState == ActorState::Active && !skip) {
     // Update components
-    for (auto comp : mComponents) {
-      if (comp->IsEnabled()) {
-        comp->Update(deltaTime);
+    for (size_t i = first; i < mComponents.size(); i++) {
+      if (mComponents[i]->IsEnabled()) {
+        mComponents[i]->Update(deltaTime);
       }
     }
 
@@ -41,6 +76,13 @@ void Actor::Update(float deltaTime) {
   }
 }
 
+void Actor::CommitParallelUpdate() {
+  if (mChunkUpdatePending) {
+    mChunkUpdatePending = false;
+    mGame->GetChunkGrid()->UpdateActor(this);
+  }
+}
+
 void Actor::ProcessInput() {
   if (mState == ActorState::Active) {
     // Process components input
@@ -66,11 +108,96 @@ void Actor::AddComponent(Component *c) {
   }
 
   mComponents.insert(iter, c);
+
+  // c goes after components of equal order, so it only becomes the first of
+  // its type if its order is lower
+  int type = static_cast<int>(c->GetComponentType());
+  Component *&first = mFirstComponents[type];
+  if (!first || order < first->GetUpdateOrder()) {
+    first = c;
+  }
 }
 
 void Actor::SetPosition(const Vector3 pos) {
-  mPosition = pos;
+  if (pos != mPosition) {
+    mPosition = pos;
+    MarkDrawsDirty();
+  }
+
+  // The ChunkGrid isn't thread-safe, parallel updates move it at the commit
+  if (mGame->IsUpdatingInParallel()) {
+    mChunkUpdatePending = true;
+    return;
+  }
 
   // Automatically update chunk grid when position changes
   mGame->GetChunkGrid()->UpdateActor(this);
 }
+
+void Actor::SetScale(const Vector3 scale) {
+  if (scale != mScale) {
+    mScale = scale;
+    MarkDrawsDirty();
+  }
+}
+
+void Actor::SetRotation(const Quaternion rotation) {
+  mRotation = rotation;
+  MarkDrawsDirty();
+}
+
+void Actor::SetStatic(bool isStatic) {
+  if (isStatic == mIsStatic) {
+    return;
+  }
+  mIsStatic = isStatic;
+
+  // Static meshes are drawn from other buckets
+  for (auto component : mComponents) {
+    if (component->GetComponentType() == ComponentType::Mesh) {
+      static_cast<MeshComponent *>(component)->RefileRenderBucket();
+    }
+  }
+}
+
+void Actor::MarkDrawsDirty() {
+  if (!mIsStatic &&
+      !mFirstComponents[static_cast<int>(ComponentType::Sprite)]) {
+    return;
+  }
+  for (auto component : mComponents) {
+    auto type = component->GetComponentType();
+    if ((type == ComponentType::Mesh && mIsStatic) ||
+        type == ComponentType::Sprite) {
+      static_cast<DrawComponent *>(component)->MarkDirty();
+    }
+  }
+}
+
+void Actor::SnapshotTransform(uint32_t step) {
+  mPrevPosition = mPosition;
+  mPrevScale = mScale;
+  mPrevRotation = mRotation;
+  mSnapshotStep = step;
+}
+
+Vector3 Actor::GetRenderPosition() const {
+  if (mSnapshotStep != mGame->GetSimulationStep()) {
+    return mPosition;
+  }
+  return Vector3::Lerp(mPrevPosition, mPosition, mGame->GetRenderAlpha());
+}
+
+Vector3 Actor::GetRenderScale() const {
+  if (mSnapshotStep != mGame->GetSimulationStep()) {
+    return mScale;
+  }
+  return Vector3::Lerp(mPrevScale, mScale, mGame->GetRenderAlpha());
+}
+
+Quaternion Actor::GetRenderRotation() const {
+  if (mSnapshotStep != mGame->GetSimulationStep()) {
+    return mRotation;
+  }
+  return Quaternion::Slerp(mPrevRotation, mRotation, mGame->GetRenderAlpha());
+}
@@ -9,11 +9,14 @@
 
 const float SHINE_TIME = 0.5f;
 
+ActorPool<NoteActor> NoteActor::sPool;
+
 NoteActor::NoteActor(Game *game, unsigned int midChannel, unsigned int midiNote,
                      Vector3 direction, Vector3 color, float speed)
     : Actor(game), mMidiChannel(midChannel), mMidiNote(midiNote),
       mIsPlaying(false), mDirection(direction), mSpeed(speed),
       mLastStepMovement(0.0f), mNotePlayerActor(nullptr), mShineActor(nullptr) {
+  sPool.OnCreated();
 
   mGame->AddAlwaysActive(this);
 
@@ -39,13 +42,73 @@ NoteActor::~NoteActor() {
   // Don't delete mShineActor - it's managed by the game's actor list
   // Just clear our pointer to it
   mShineActor = nullptr;
+  sPool.OnDeleted();
+}
+
+NoteActor *NoteActor::Spawn(NotePlayerActor *notePlayerActor, Game *game,
+                            unsigned int midChannel, unsigned int midiNote,
+                            Vector3 direction, Vector3 color, float speed) {
+  NoteActor *note = sPool.Acquire();
+  if (!note) {
+    return new NoteActor(notePlayerActor, game, midChannel, midiNote,
+                         direction, color, speed);
+  }
+
+  // Same state and registration as a new actor
+  note->mState = ActorState::Active;
+  note->mPosition = Vector3::Zero;
+  note->mScale = Vector3::One;
+  game->AddActor(note);
+  game->AddAlwaysActive(note);
+
+  note->Reset(midChannel, midiNote, direction, color, speed);
+  note->mNotePlayerActor = notePlayerActor;
+  return note;
+}
+
+bool NoteActor::Recycle() {
+  // Detach like the destructor does
+  mGame->RemoveActor(this);
+  if (mNotePlayerActor) {
+    mNotePlayerActor->MarkNoteDead(this);
+    mNotePlayerActor = nullptr;
+  }
+
+  // Let the shine fade out on its own (it may have been recycled already in
+  // this same pass)
+  if (mShineActor && mShineActor->GetState() != ActorState::Destroy) {
+    mShineActor->SetAutoDestroy(true);
+    mShineActor = nullptr;
+  }
+
+  sPool.Release(this);
+  return true;
+}
+
+void NoteActor::Reset(unsigned int midChannel, unsigned int midiNote,
+                      Vector3 direction, Vector3 color, float speed) {
+  mMidiChannel = midChannel;
+  mMidiNote = midiNote;
+  mIsPlaying = false;
+  mDirection = direction;
+  mSpeed = speed;
+  mLastStepMovement = 0.0f;
+  mNotePlayerActor = nullptr;
+  mShineActor = nullptr;
+
+  mRigidBodyComponent->SetVelocity(Vector3::Zero);
+  mMeshComponent->SetColor(color);
+  mMeshComponent->SetBloomed(true);
+
+  SetScale(Vector3(0.4f, 0.4f, 0.1f));
+  SetRotation(Math::LookRotation(mDirection));
 }
 
 void NoteActor::Start() {
   mIsPlaying = true;
   mRigidBodyComponent->SetVelocity(Vector3::Normalize(mDirection) * mSpeed);
 
-  mShineActor = new ShineActor(mGame, mMeshComponent->GetColor(), false);
+  mShineActor = ShineActor::Spawn(mGame, mMeshComponent->GetColor(), false);
   mShineActor->SetPosition(mPosition - mDirection * mScale.z * 0.5f);
   mShineActor->Start(SHINE_TIME);
   mShineActor->GetComponent<SpriteComponent>()->SetBloomed(true);
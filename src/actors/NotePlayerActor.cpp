@@ -22,8 +22,8 @@ bool NotePlayerActor::PlayNote(unsigned int note, unsigned int channel,
 
   Vector3 right = Vector3::Cross(Vector3::UnitY, front);
 
-  mActiveNotes[noteIndex] = new NoteActor(this, mGame, channel, note, front,
-                                          NOTE_COLORS[channel], speed);
+  mActiveNotes[noteIndex] = NoteActor::Spawn(this, mGame, channel, note, front,
+                                             NOTE_COLORS[channel], speed);
 
   float offset = 0.5f * MAX_NOTES * noteSpacing + noteSpacing / 2.0f;
 
@@ -44,7 +44,7 @@ void ItemActor::OnCollision(Vector3 penetration, ColliderComponent *other) {
     // AQUI: lógica de inventário / poderes
 
     // Animação de brilho ao coletar
-    auto shine = new ShineActor(mGame, mMeshComponent->GetColor());
+    auto shine = ShineActor::Spawn(mGame, mMeshComponent->GetColor());
     shine->SetPosition(mPosition);
     shine->Start(0.5f);
     SetState(ActorState::Destroy);
@@ -104,7 +104,7 @@ void BreakableBox::OnCollision(Vector3 penetration, ColliderComponent *other) {
 
     // Only destroy if health reaches 0
     if (mHealth <= 0) {
-      auto shine = new ShineActor(mGame, Vector3(0.3f, 0.1f, 0.0f));
+      auto shine = ShineActor::Spawn(mGame, Vector3(0.3f, 0.1f, 0.0f));
 
       shine->SetPosition(mPosition);
       shine->GetComponent<SpriteComponent>()->SetBloomed(false);
@@ -143,7 +143,7 @@ void MovableBox::OnCollision(Vector3 penetration, ColliderComponent *other) {
     if (move.Length() > 0.001f) {
       MIDIPlayer::playSequence(
           {{0.0f, 13, 29, true, 20}, {0.1f, 13, 29, false}});
-      mPosition += move;
+      SetPosition(mPosition + move);
     }
   } else if (other->GetLayer() == ColliderLayer::Hole) {
 
@@ -163,17 +163,19 @@ void MovableBox::OnCollision(Vector3 penetration, ColliderComponent *other) {
       mIsInHole = true;
 
       if (mPosition.y > 0.5f) {
-        mPosition.y = Math::Lerp(mPosition.y, 0.5f, 0.1f);
+        Vector3 pos = mPosition;
+        pos.y = Math::Lerp(pos.y, 0.5f, 0.1f);
 
-        if (mPosition.y <= 0.6f) {
-          mPosition.y = 0.5f;
+        if (pos.y <= 0.6f) {
+          pos.y = 0.5f;
         } else {
           // Note pitch proportional to height
-          int note = static_cast<int>(Math::Lerp(30.0f, 90.0f, mPosition.y));
+          int note = static_cast<int>(Math::Lerp(30.0f, 90.0f, pos.y));
           // Play falling sound on channel 15
           MIDIPlayer::playSequence(
               {{0.0f, 15, note, true, 100}, {0.01f, 15, note, false}});
         }
+        SetPosition(pos);
       }
     }
     // else: Box is not fully over the hole - ignore collision and let player
@@ -307,7 +309,7 @@ void MusicButtonActor::Activate() {
   // mMeshComp->SetColor(Vector3(0.0f, 1.0f, 0.0f));
   // mMeshComp->SetBloomed(true);
 
-  ShineActor *shine = new ShineActor(GetGame(), mMeshComp->GetColor());
+  ShineActor *shine = ShineActor::Spawn(GetGame(), mMeshComp->GetColor());
   shine->SetPosition(GetPosition());
   shine->Start(0.5f);
 
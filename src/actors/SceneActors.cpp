@@ -22,7 +22,7 @@
 // CubeActor implementation
 CubeActor::CubeActor(Game *game, const Vector3 &color, int startingIndex)
     : Actor(game), mMeshComponent(nullptr) {
-  mGame->AddAlwaysActive(this);
+  mGame->AddStaticActor(this);
   std::string levelPath = game->GetLevelAssetPath();
   Texture *texture = game->GetRenderer()->LoadTexture(levelPath + "cubes.png");
   // Get atlas from renderer cache
@@ -58,7 +58,7 @@ void SolidCubeActor::OnUpdate(float deltaTime) {
 // WallActor implementation
 WallActor::WallActor(Game *game, const Vector3 &color, int startingIndex)
     : Actor(game), mMeshComponent(nullptr) {
-  mGame->AddAlwaysActive(this);
+  mGame->AddStaticActor(this);
   std::string levelPath = game->GetLevelAssetPath();
   Texture *texture = game->GetRenderer()->LoadTexture(levelPath + "wall.png");
   // Get atlas from renderer cache
@@ -163,6 +163,9 @@ TreeActor::TreeActor(Game *game) : Actor(game) {
       this, ColliderLayer::Ground, Vector3(0.0f, 0.0f, 0.0f), 0.5f, true);
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  // Sway only rotates the own sprite (safe to update in parallel)
+  SetParallelUpdate(true);
 }
 
 void TreeActor::OnUpdate(float deltaTime) {
@@ -208,6 +211,8 @@ VisualTree::VisualTree(Game *game) : Actor(game) {
   }
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  SetParallelUpdate(true);
 }
 
 void VisualTree::OnUpdate(float deltaTime) {
@@ -293,6 +298,8 @@ BushActor::BushActor(Game *game) : Actor(game) {
   }
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  SetParallelUpdate(true);
 }
 
 void BushActor::OnUpdate(float deltaTime) {
@@ -335,6 +342,8 @@ GrassActorA::GrassActorA(Game *game) : Actor(game), mSpriteComponent(nullptr) {
   mSpriteComponent->SetAnimation("idle");
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  SetParallelUpdate(true);
 }
 
 void GrassActorA::OnUpdate(float deltaTime) {
@@ -377,6 +386,8 @@ GrassActorB::GrassActorB(Game *game) : Actor(game), mSpriteComponent(nullptr) {
   mSpriteComponent->SetAnimation("idle");
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  SetParallelUpdate(true);
 }
 
 void GrassActorB::OnUpdate(float deltaTime) {
@@ -417,6 +428,8 @@ GrassActorC::GrassActorC(Game *game) : Actor(game), mSpriteComponent(nullptr) {
   mSpriteComponent->SetAnimation("idle");
 
   mSwayPhase = static_cast<float>(rand()) / RAND_MAX * 2 * 3.14159f;
+
+  SetParallelUpdate(true);
 }
 
 void GrassActorC::OnUpdate(float deltaTime) {
@@ -431,7 +444,7 @@ GroundActor::GroundActor(Game *game, const Vector3 &color, int startingIndex)
   std::string levelPath = game->GetLevelAssetPath();
   Texture *texture = game->GetRenderer()->LoadTexture(levelPath + "floor.png");
 
-  mGame->AddAlwaysActive(this);
+  mGame->AddStaticActor(this);
 
   // Get atlas from renderer cache
   TextureAtlas *atlas =
@@ -515,11 +528,13 @@ void MultiDrawablesActor::OnUpdate(float deltaTime) {
   mRotation = Quaternion::Concatenate(
       mRotation, Quaternion(Vector3::UnitY, deltaTime * 0.2));
 
-  mPosition.y = 2.0f - 1.0f * Math::Sin(4.0f * SDL_GetTicks() / 10000.0f);
+  float phase = 4.0f * mGame->GetTicksCount() / 10000.0f;
+
+  mPosition.y = 2.0f - 1.0f * Math::Sin(phase);
 
-  mScale = Vector3(5.0f + 3.0f * Math::Cos(4.0f * SDL_GetTicks() / 10000.0f),
-                   3.0f - 2.0f * Math::Sin(4.0f * SDL_GetTicks() / 10000.0f),
-                   (5.0f - 3.0f * Math::Sin(4.0f * SDL_GetTicks() / 10000.0f)));
+  mScale = Vector3(5.0f + 3.0f * Math::Cos(phase),
+                   3.0f - 2.0f * Math::Sin(phase),
+                   (5.0f - 3.0f * Math::Sin(phase)));
 }
 
 PyramidActor::PyramidActor(Game *game, const Vector3 &color, int startingIndex)
@@ -545,9 +560,8 @@ PyramidActor::PyramidActor(Game *game, const Vector3 &color, int startingIndex)
   mMeshComponent->SetBloomed(true);
 }
 
-Hole::Hole(Game *game, const Vector3 &color) : GroundActor(game, color, -1) {
+Hole::Hole(Game *game) : Actor(game) {
   mGame->AddAlwaysActive(this);
-  mMeshComponent->SetBloomed(true);
   mColliderComponent =
       new AABBCollider(this, ColliderLayer::Hole, Vector3(0.0f, 1.0f, 0.0f),
                        Vector3(0.5f, 0.5f, 0.5f), true);
@@ -562,6 +576,9 @@ Hole::Hole(Game *game, const Vector3 &color) : GroundActor(game, color, -1) {
 }
 
 void Hole::OnUpdate(float deltaTime) {
+  // The lift raises every hole surface of the tilemap at once, above its
+  // border
+  GroundTilemap &ground = mGame->GetRenderer()->GetGroundTilemap();
   if (mGame->GetBattleSystem()->IsInBattle() &&
       !mGame->GetBattleSystem()->IsTransitioning()) {
     if (mBorder->IsVisible() == false) {
@@ -569,33 +586,20 @@ void Hole::OnUpdate(float deltaTime) {
           Vector3(0.1f / mScale.x + 1.0, 1.0f, 0.1f / mScale.z + 1.0));
       mBorder->SetVisible(true);
       mBorder->SetOffset(Vector3(0.0f, 0.46f, 0.0f));
-      mMeshComponent->SetOffset(Vector3(0.0f, 0.47f, 0.0f));
+      ground.SetLift(0.47f);
     }
 
   } else {
     if (mBorder->IsVisible()) {
-      Vector3 offset = mMeshComponent->GetOffset();
-      offset.y = 0.0f;
-      mMeshComponent->SetOffset(offset);
+      ground.SetLift(0.0f);
       mBorder->SetVisible(false);
     }
   }
 }
 
-void Water::OnUpdate(float deltaTime) {
-  // Change texture with animtimer
-  mAnimTimer += deltaTime;
-  if (mAnimTimer >= 0.25f) {
-    mAnimTimer = 0.0f;
-    mCurrentFrame = (mCurrentFrame + 1) % 2;
-    mMeshComponent->SetTextureIndex(51 + mCurrentFrame);
-  }
-
-  Hole::OnUpdate(deltaTime);
-}
-
 HouseActor::HouseActor(Game *game)
     : Actor(game), mMeshComponent1(nullptr), mMeshComponent2(nullptr) {
+  mGame->AddStaticActor(this);
 
   std::string levelPath = game->GetLevelAssetPath();
   // First MeshComponent - Cube
@@ -6,9 +6,15 @@
 #include "components/SpriteComponent.hpp"
 #include <random>
 
+ActorPool<ShineActor> ShineActor::sPool;
+
 ShineActor::ShineActor(Game *game, Vector3 color, bool autoDestroy)
-    : Actor(game), mLifetime(0.0f), mAutoDestroy(autoDestroy) {
+    : Actor(game), mLifetime(0.0f), mAutoDestroy(autoDestroy),
+      mFinished(false) {
+  sPool.OnCreated();
   game->AddAlwaysActive(this);
+  // Fading only touches the shine and its sprite
+  SetParallelUpdate(true);
   // Get atlas from renderer cache
   TextureAtlas *atlas =
     game->GetRenderer()->LoadAtlas(getAssetPath("textures/shine.json"));
@@ -21,10 +27,44 @@ ShineActor::ShineActor(Game *game, Vector3 color, bool autoDestroy)
 
   mSpriteComponent = new SpriteComponent(this, textureIndex, atlas);
 
-  mSpriteComponent->SetColor(color);
   mSpriteComponent->AddAnimation(
       "shine", {"s1.png", "s2.png", "s3.png", "s4.png", "s5.png"}, false);
 
+  Reset(color, autoDestroy);
+}
+
+ShineActor::~ShineActor() { sPool.OnDeleted(); }
+
+ShineActor *ShineActor::Spawn(Game *game, Vector3 color, bool autoDestroy) {
+  ShineActor *shine = sPool.Acquire();
+  if (!shine) {
+    return new ShineActor(game, color, autoDestroy);
+  }
+
+  // Same state and registration as a new actor
+  shine->mState = ActorState::Active;
+  shine->mPosition = Vector3::Zero;
+  shine->mScale = Vector3::One;
+  shine->mRotation = Quaternion::Identity;
+  game->AddActor(shine);
+  game->AddAlwaysActive(shine);
+
+  shine->Reset(color, autoDestroy);
+  return shine;
+}
+
+bool ShineActor::Recycle() {
+  mGame->RemoveActor(this);
+  sPool.Release(this);
+  return true;
+}
+
+void ShineActor::Reset(Vector3 color, bool autoDestroy) {
+  mLifetime = 0.0f;
+  mAutoDestroy = autoDestroy;
+  mFinished = false;
+
+  mSpriteComponent->SetColor(color);
   mSpriteComponent->SetBloomed(true);
   mSpriteComponent->SetAnimation("shine");
   mSpriteComponent->SetAnimFPS(10.0f);
@@ -49,6 +89,7 @@ void ShineActor::OnUpdate(float deltaTime) {
   }
   mLifetime -= deltaTime;
   if (mLifetime <= 0.0f) {
+    mFinished = true;
     mSpriteComponent->SetVisible(false);
     mSpriteComponent->SetIsPaused(true);
     if (mAutoDestroy) {
@@ -61,8 +102,18 @@ void ShineActor::OnUpdate(float deltaTime) {
 
 void ShineActor::Start(float lifetime) {
   mLifetime = lifetime;
+  mFinished = false;
   mScale = Vector3::One;
   mSpriteComponent->SetVisible(true);
   mSpriteComponent->SetAnimationTimer(0.0f);
   mSpriteComponent->SetIsPaused(false);
 }
+
+void ShineActor::SetAutoDestroy(bool autoDestroy) {
+  mAutoDestroy = autoDestroy;
+
+  // Otherwise a finished shine would stay around, invisible, forever
+  if (mAutoDestroy && mFinished) {
+    SetState(ActorState::Destroy);
+  }
+}
@@ -12,7 +12,7 @@
 ColliderComponent::ColliderComponent(Actor *owner, ColliderLayer layer,
                                      ColliderType type, bool isStatic,
                                      int updateOrder)
-    : Component(owner, updateOrder), mLayer(layer), mType(type),
+    : Component(owner, updateOrder, TYPE), mLayer(layer), mType(type),
       mIsStatic(isStatic) {}
 
 ColliderComponent::~ColliderComponent() {}
@@ -185,6 +185,16 @@ Vector3 AABBCollider::DetectCollision(const ColliderComponent &other) const {
   return Vector3::Zero;
 }
 
+void AABBCollider::GetBounds(Vector3 &outMin, Vector3 &outMax) const {
+  // Negative scales can swap min and max
+  Vector3 a = GetMin();
+  Vector3 b = GetMax();
+  outMin =
+      Vector3(Math::Min(a.x, b.x), Math::Min(a.y, b.y), Math::Min(a.z, b.z));
+  outMax =
+      Vector3(Math::Max(a.x, b.x), Math::Max(a.y, b.y), Math::Max(a.z, b.z));
+}
+
 void AABBCollider::DebugDraw(class Renderer *renderer) {
   // Get the cube mesh from the renderer
   Mesh *cubeMesh = renderer->LoadMesh("cube");
@@ -731,6 +741,30 @@ Vector3 OBBCollider::DetectCollision(const ColliderComponent &other) const {
   return Vector3::Zero;
 }
 
+void OBBCollider::GetBounds(Vector3 &outMin, Vector3 &outMax) const {
+  Matrix4 rot = Matrix4::CreateFromQuaternion(mOwner->GetRotation());
+  Vector3 scale = mOwner->GetScale();
+  Vector3 extents =
+      Vector3(mSize.x * Math::Abs(scale.x), mSize.y * Math::Abs(scale.y),
+              mSize.z * Math::Abs(scale.z));
+
+  // Project the rotated extents onto the world axes
+  Vector3 halfSize;
+  halfSize.x = Math::Abs(rot.mat[0][0]) * extents.x +
+               Math::Abs(rot.mat[1][0]) * extents.y +
+               Math::Abs(rot.mat[2][0]) * extents.z;
+  halfSize.y = Math::Abs(rot.mat[0][1]) * extents.x +
+               Math::Abs(rot.mat[1][1]) * extents.y +
+               Math::Abs(rot.mat[2][1]) * extents.z;
+  halfSize.z = Math::Abs(rot.mat[0][2]) * extents.x +
+               Math::Abs(rot.mat[1][2]) * extents.y +
+               Math::Abs(rot.mat[2][2]) * extents.z;
+
+  Vector3 center = GetCenter();
+  outMin = center - halfSize;
+  outMax = center + halfSize;
+}
+
 void OBBCollider::DebugDraw(class Renderer *renderer) {
   // Get the cube mesh from the renderer
   Mesh *cubeMesh = renderer->LoadMesh("cube");
@@ -844,6 +878,13 @@ Vector3 SphereCollider::DetectCollision(const ColliderComponent &other) const {
   return Vector3::Zero;
 }
 
+void SphereCollider::GetBounds(Vector3 &outMin, Vector3 &outMax) const {
+  float radius = Math::Abs(GetRadius());
+  Vector3 center = GetCenter();
+  outMin = center - Vector3(radius);
+  outMax = center + Vector3(radius);
+}
+
 void SphereCollider::DebugDraw(Renderer *renderer) {
   // Get the sphere mesh from the renderer
   Mesh *sphereMesh = renderer->LoadMesh("sphere");
@@ -1,8 +1,9 @@
 #include "components/Component.hpp"
 #include "actors/Actor.hpp"
 
-Component::Component(Actor *owner, int updateOrder)
-    : mOwner(owner), mUpdateOrder(updateOrder), mIsEnabled(true) {
+Component::Component(Actor *owner, int updateOrder, ComponentType type)
+    : mOwner(owner), mUpdateOrder(updateOrder), mIsEnabled(true),
+      mComponentType(type), mParallelUpdate(false) {
   mOwner->AddComponent(this);
 }
 
@@ -2,10 +2,28 @@
 #include "Game.hpp"
 #include "actors/Actor.hpp"
 
-DrawComponent::DrawComponent(Actor *owner)
-    : Component(owner, 50) // Draw components update at order 50
+DrawComponent::DrawComponent(Actor *owner, ComponentType type)
+    : Component(owner, 50, type) // Draw components update at order 50
       ,
       mIsVisible(true), mIsBloomed(false), mColor(Color::White),
       mOffset(Vector3::Zero), mScale(Vector3::One) {}
 
 DrawComponent::~DrawComponent() {}
+
+void DrawComponent::SetVisible(bool visible) {
+  if (visible != mIsVisible) {
+    mIsVisible = visible;
+    RefileRenderBucket();
+  }
+}
+
+void DrawComponent::SetBloomed(bool bloomed) {
+  if (bloomed != mIsBloomed) {
+    mIsBloomed = bloomed;
+    RefileRenderBucket();
+  }
+}
+
+void DrawComponent::RefileRenderBucket() {
+  GetGame()->DeferCommit([this]() { UpdateRenderBucket(); });
+}
@@ -41,7 +41,7 @@ void computeAutomaton(std::vector<std::vector<int>> &aut,
 
 MelodyComponent::MelodyComponent(class Actor *owner, std::vector<int> melody,
                                  float timer)
-    : Component(owner), sequence(melody), timer(timer) {}
+    : Component(owner, 100, TYPE), sequence(melody), timer(timer) {}
 
 void MelodyComponent::Update(float deltaTime) {
   if (FullMatch())
@@ -7,8 +7,24 @@
 
 MeshComponent::MeshComponent(Actor *owner, Mesh &mesh, Texture *texture,
                              TextureAtlas *textureAtlas, int startingIndex)
-    : DrawComponent(owner), mRelativeRotation(Quaternion::Identity),
+    : DrawComponent(owner, TYPE), mRelativeRotation(Quaternion::Identity),
       mMesh(mesh), mTexture(texture), mTextureAtlas(textureAtlas),
-      mStartingIndex(startingIndex) {}
+      mStartingIndex(startingIndex), mBucket(nullptr), mBucketIndex(0),
+      mChunk(nullptr), mChunkIndex(0), mInstance{}, mBoundsCenter(Vector3::Zero),
+      mBoundsExtents(Vector3::Zero), mInstanceDirty(true) {
+  RefileRenderBucket();
+}
 
-MeshComponent::~MeshComponent() {}
+MeshComponent::~MeshComponent() {
+  if (auto renderer = GetGame()->GetRenderer()) {
+    renderer->GetRenderBuckets().Remove(this);
+  }
+}
+
+void MeshComponent::UpdateRenderBucket() {
+  // The instance holds the bloom flag
+  mInstanceDirty = true;
+  if (auto renderer = GetGame()->GetRenderer()) {
+    renderer->GetRenderBuckets().Update(this);
+  }
+}
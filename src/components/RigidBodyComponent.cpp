@@ -6,9 +6,12 @@ const float MAX_SPEED = 750.0f;
 
 RigidBodyComponent::RigidBodyComponent(Actor *owner, float mass, float friction,
                                        bool applyGravity, int updateOrder)
-    : Component(owner, updateOrder), mMass(mass), mApplyGravity(applyGravity),
+    : Component(owner, updateOrder, TYPE), mMass(mass), mApplyGravity(applyGravity),
       mFriction(friction), mVelocity(Vector3::Zero),
-      mAcceleration(Vector3::Zero) {}
+      mAcceleration(Vector3::Zero) {
+  // Integration only moves the owner (its chunk move is deferred)
+  mParallelUpdate = true;
+}
 
 RigidBodyComponent::~RigidBodyComponent() {}
 
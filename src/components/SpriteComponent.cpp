@@ -1,5 +1,6 @@
 #include "components/SpriteComponent.hpp"
 #include "Game.hpp"
+#include "UI/Screen/UIScreen.hpp"
 #include "actors/Actor.hpp"
 #include "render/Renderer.hpp"
 #include "render/TextureAtlas.hpp"
@@ -9,20 +10,56 @@
 
 SpriteComponent::SpriteComponent(Actor *owner, int textureIndex,
                                  TextureAtlas *atlas, bool isHUD)
-    : DrawComponent(owner), mTextureIndex(textureIndex), mAnimTimer(0.0f),
+    : DrawComponent(owner, TYPE), mTextureIndex(textureIndex), mAnimTimer(0.0f),
       mAnimFPS(24.0f), mIsPaused(false), mTextureAtlas(atlas), mIsHUD(isHUD),
-      mRotation(0.0f) {}
+      mScreen(nullptr), mRotation(0.0f), mBucket(nullptr), mBucketIndex(0) {
+  // Animation only advances this sprite's timer
+  mParallelUpdate = true;
+  RefileRenderBucket();
+}
 
 SpriteComponent::~SpriteComponent() {
+  if (auto renderer = GetGame()->GetRenderer()) {
+    renderer->GetRenderBuckets().Remove(this);
+  }
   mAnimations.clear();
   mSpriteSheetData.clear();
 }
 
+void SpriteComponent::SetTextureAtlas(TextureAtlas *atlas) {
+  if (atlas != mTextureAtlas) {
+    mTextureAtlas = atlas;
+    MarkDirty();
+    RefileRenderBucket();
+  }
+}
+
+void SpriteComponent::SetTextureIndex(int idx) {
+  if (idx != mTextureIndex) {
+    mTextureIndex = idx;
+    MarkDirty();
+    RefileRenderBucket();
+  }
+}
+
+void SpriteComponent::MarkDirty() {
+  if (mScreen) {
+    mScreen->MarkHUDDirty();
+  }
+}
+
+void SpriteComponent::UpdateRenderBucket() {
+  if (auto renderer = GetGame()->GetRenderer()) {
+    renderer->GetRenderBuckets().Update(this);
+  }
+}
+
 void SpriteComponent::Update(float deltaTime) {
   if (mIsPaused || mAnimations.empty() || mAnimName.empty())
     return;
 
   auto &anim = mAnimations[mAnimName];
+  int frame = static_cast<int>(mAnimTimer);
   mAnimTimer += mAnimFPS * deltaTime;
 
   float frameCount = static_cast<float>(anim.frameIndices.size());
@@ -38,10 +75,18 @@ void SpriteComponent::Update(float deltaTime) {
       }
     }
   }
+
+  // Only a new frame changes what is drawn
+  if (static_cast<int>(mAnimTimer) != frame) {
+    MarkDirty();
+  }
 }
 
 void SpriteComponent::SetAnimation(const std::string &name) {
   if (mAnimations.find(name) != mAnimations.end()) {
+    if (name != mAnimName) {
+      MarkDirty();
+    }
     mAnimName = name;
     auto &anim = mAnimations[mAnimName];
     float frameCount = static_cast<float>(anim.frameIndices.size());
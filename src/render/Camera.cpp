@@ -5,7 +5,8 @@
 
 Camera::Camera(class Game *game, const Vector3 &eye, const Quaternion rotation,
                float moveSpeed, float turnSpeed)
-    : mGame(game), mPosition(eye), mRotation(rotation),
+    : mGame(game), mPosition(eye), mRotation(rotation), mPrevPosition(eye),
+      mPrevRotation(rotation),
       mMode(CameraMode::Fixed), mMoveSpeed(moveSpeed), mTurnSpeed(turnSpeed),
       mIsometricDirection(IsometricDirections::North) {}
 
@@ -37,12 +38,34 @@ Quaternion Camera::ISOMETRIC_DIRECTIONS[8] = {
 };
 
 Matrix4 Camera::GetCameraMatrix() const {
-  const auto mCameraForward = Vector3::Transform(Vector3::UnitZ, mRotation);
-  const auto mCameraUp = Vector3::Transform(Vector3::UnitY, mRotation);
-  return Matrix4::CreateLookAt(mPosition, mPosition + mCameraForward,
+  return GetCameraMatrix(mPosition, mRotation);
+}
+
+Matrix4 Camera::GetCameraMatrix(const Vector3 &position,
+                                const Quaternion &rotation) {
+  const auto mCameraForward = Vector3::Transform(Vector3::UnitZ, rotation);
+  const auto mCameraUp = Vector3::Transform(Vector3::UnitY, rotation);
+  return Matrix4::CreateLookAt(position, position + mCameraForward,
                                mCameraUp);
 }
 
+void Camera::SnapshotTransform() {
+  mPrevPosition = mPosition;
+  mPrevRotation = mRotation;
+}
+
+void Camera::UpdateViewMatrix(float alpha) {
+  ApplyViewMatrix(
+      GetCameraMatrix(Vector3::Lerp(mPrevPosition, mPosition, alpha),
+                      Quaternion::Slerp(mPrevRotation, mRotation, alpha)));
+}
+
+void Camera::ApplyViewMatrix(const Matrix4 &view) {
+  Renderer *renderer = mGame->GetRenderer();
+  renderer->SetViewMatrix(view);
+  mFrustum = Frustum(view * renderer->GetProjectionMatrix());
+}
+
 void Camera::SetCameraForward(const Vector3 &forward) {
   const auto cameraUp = Vector3::Transform(Vector3::UnitY, mRotation);
   mRotation = Math::LookRotation(forward, cameraUp);
@@ -78,5 +101,5 @@ void Camera::Update(float deltaTime) {
                                   mTurnSpeed * deltaTime));
     break;
   }
-  mGame->GetRenderer()->SetViewMatrix(GetCameraMatrix());
+  ApplyViewMatrix(GetCameraMatrix());
 }
@@ -0,0 +1,86 @@
+#include "render/Frustum.hpp"
+#include <cmath>
+
+void BoundsArray::Resize(size_t count) {
+  for (auto *values :
+       {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ}) {
+    values->resize(count);
+  }
+}
+
+void BoundsArray::Set(size_t index, const Vector3 &center,
+                      const Vector3 &extents) {
+  centerX[index] = center.x;
+  centerY[index] = center.y;
+  centerZ[index] = center.z;
+  extentX[index] = extents.x;
+  extentY[index] = extents.y;
+  extentZ[index] = extents.z;
+}
+
+Frustum::Frustum() {
+  for (auto &plane : mPlanes) {
+    plane[0] = plane[1] = plane[2] = 0.0f;
+    plane[3] = 1.0f;
+  }
+}
+
+Frustum::Frustum(const Matrix4 &viewProjection) {
+  // Clip coordinates are v * M, so each clip component is a column of M.
+  // GL keeps -w <= x, y, z <= w
+  auto column = [&viewProjection](int col, int row) {
+    return viewProjection.mat[row][col];
+  };
+  for (int axis = 0; axis < 3; axis++) {
+    for (int row = 0; row < 4; row++) {
+      mPlanes[axis * 2][row] = column(3, row) + column(axis, row);
+      mPlanes[axis * 2 + 1][row] = column(3, row) - column(axis, row);
+    }
+  }
+}
+
+bool Frustum::Intersects(const Vector3 &center, const Vector3 &extents) const {
+  for (const auto &plane : mPlanes) {
+    float distance = plane[0] * center.x + plane[1] * center.y +
+                     plane[2] * center.z + plane[3];
+    float radius = std::fabs(plane[0]) * extents.x +
+                   std::fabs(plane[1]) * extents.y +
+                   std::fabs(plane[2]) * extents.z;
+    if (distance + radius < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t Frustum::Cull(const BoundsArray &bounds, size_t count,
+                     uint8_t *visible) const {
+  const float *cx = bounds.centerX.data();
+  const float *cy = bounds.centerY.data();
+  const float *cz = bounds.centerZ.data();
+  const float *ex = bounds.extentX.data();
+  const float *ey = bounds.extentY.data();
+  const float *ez = bounds.extentZ.data();
+
+  for (size_t i = 0; i < count; i++) {
+    visible[i] = 1;
+  }
+
+  // One plane at a time over every box: branch-free loops the compiler
+  // vectorizes
+  for (const auto &plane : mPlanes) {
+    const float a = plane[0], b = plane[1], c = plane[2], d = plane[3];
+    const float absA = std::fabs(a), absB = std::fabs(b), absC = std::fabs(c);
+    for (size_t i = 0; i < count; i++) {
+      float distance = a * cx[i] + b * cy[i] + c * cz[i] + d;
+      float radius = absA * ex[i] + absB * ey[i] + absC * ez[i];
+      visible[i] &= static_cast<uint8_t>(distance + radius >= 0.0f);
+    }
+  }
+
+  size_t visibleCount = 0;
+  for (size_t i = 0; i < count; i++) {
+    visibleCount += visible[i];
+  }
+  return visibleCount;
+}
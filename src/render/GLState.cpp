@@ -0,0 +1,116 @@
+#include "render/GLState.hpp"
+
+GLuint GLState::sProgram = GLState::UNKNOWN;
+GLuint GLState::sActiveUnit = GLState::UNKNOWN;
+GLuint GLState::sTextures[GLState::TEXTURE_UNITS];
+GLuint GLState::sVertexArray = GLState::UNKNOWN;
+GLuint GLState::sFramebuffer = GLState::UNKNOWN;
+GLuint GLState::sDepthTest = GLState::UNKNOWN;
+GLuint GLState::sCullFace = GLState::UNKNOWN;
+GLuint GLState::sBlend = GLState::UNKNOWN;
+GLuint GLState::sPolygonMode = GLState::UNKNOWN;
+size_t GLState::sCalls = 0;
+size_t GLState::sSkipped = 0;
+
+bool GLState::Change(GLuint &cached, GLuint value) {
+  if (cached == value) {
+    sSkipped++;
+    return false;
+  }
+  cached = value;
+  sCalls++;
+  return true;
+}
+
+void GLState::UseProgram(GLuint program) {
+  if (Change(sProgram, program)) {
+    glUseProgram(program);
+  }
+}
+
+void GLState::BindTexture(GLuint unit, GLuint texture, GLenum target) {
+  // Units past the cached ones are always bound
+  if (unit >= TEXTURE_UNITS) {
+    sActiveUnit = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(target, texture);
+    sCalls += 2;
+    return;
+  }
+
+  // The unit is left active, texture uploads and parameters that follow go
+  // to it. Texture names are unique across targets, so the name alone
+  // identifies the binding
+  if (Change(sActiveUnit, unit)) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+  if (Change(sTextures[unit], texture)) {
+    glBindTexture(target, texture);
+  }
+}
+
+void GLState::BindVertexArray(GLuint vertexArray) {
+  if (Change(sVertexArray, vertexArray)) {
+    glBindVertexArray(vertexArray);
+  }
+}
+
+void GLState::BindFramebuffer(GLuint framebuffer) {
+  if (Change(sFramebuffer, framebuffer)) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  }
+}
+
+void GLState::SetEnabled(GLenum capability, bool enabled) {
+  GLuint *cached = nullptr;
+  switch (capability) {
+  case GL_DEPTH_TEST:
+    cached = &sDepthTest;
+    break;
+  case GL_CULL_FACE:
+    cached = &sCullFace;
+    break;
+  case GL_BLEND:
+    cached = &sBlend;
+    break;
+  default:
+    break;
+  }
+
+  if (cached && !Change(*cached, enabled ? 1 : 0)) {
+    return;
+  }
+  if (!cached) {
+    sCalls++;
+  }
+  if (enabled) {
+    glEnable(capability);
+  } else {
+    glDisable(capability);
+  }
+}
+
+void GLState::SetPolygonMode(GLenum mode) {
+  if (Change(sPolygonMode, mode)) {
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+  }
+}
+
+void GLState::Invalidate() {
+  sProgram = UNKNOWN;
+  sActiveUnit = UNKNOWN;
+  for (auto &texture : sTextures) {
+    texture = UNKNOWN;
+  }
+  sVertexArray = UNKNOWN;
+  sFramebuffer = UNKNOWN;
+  sDepthTest = UNKNOWN;
+  sCullFace = UNKNOWN;
+  sBlend = UNKNOWN;
+  sPolygonMode = UNKNOWN;
+}
+
+void GLState::ResetCounters() {
+  sCalls = 0;
+  sSkipped = 0;
+}
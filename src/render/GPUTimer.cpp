@@ -0,0 +1,130 @@
+#include "render/GPUTimer.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+GPUTimer::GPUTimer()
+    : mQueries{}, mIssued{}, mSet(0), mActivePass(-1), mInitialized(false),
+      mCollected(false), mSamples{}, mSampleCount{}, mSampleIndex{} {}
+
+GPUTimer::~GPUTimer() { Shutdown(); }
+
+bool GPUTimer::Initialize() {
+  // Timer queries are core since GL 3.3 (llvmpipe has them too)
+  glGenQueries(2 * PASS_COUNT, &mQueries[0][0]);
+  if (mQueries[0][0] == 0) {
+    std::cerr << "Failed to create the GPU timer queries" << std::endl;
+    return false;
+  }
+  mInitialized = true;
+  return true;
+}
+
+void GPUTimer::Shutdown() {
+  if (!mInitialized) {
+    return;
+  }
+  if (mActivePass >= 0) {
+    glEndQuery(GL_TIME_ELAPSED);
+    mActivePass = -1;
+  }
+  glDeleteQueries(2 * PASS_COUNT, &mQueries[0][0]);
+  mInitialized = false;
+}
+
+void GPUTimer::Begin(GPUPass pass) {
+  if (!mInitialized || mActivePass >= 0) {
+    return;
+  }
+  int index = static_cast<int>(pass);
+  mActivePass = index;
+  glBeginQuery(GL_TIME_ELAPSED, mQueries[mSet][index]);
+  mIssued[mSet][index] = true;
+}
+
+void GPUTimer::End() {
+  if (mActivePass < 0) {
+    return;
+  }
+  glEndQuery(GL_TIME_ELAPSED);
+  mActivePass = -1;
+}
+
+void GPUTimer::EndFrame() {
+  if (!mInitialized) {
+    return;
+  }
+  End();
+
+  // Collect the frame before, issued in the other set. Its queries finish in
+  // order, the last one being ready means they all are. Otherwise the frame
+  // is dropped
+  int previous = 1 - mSet;
+  int last = -1;
+  for (int i = 0; i < PASS_COUNT; i++) {
+    if (mIssued[previous][i]) {
+      last = i;
+    }
+  }
+  if (last >= 0) {
+    GLint available = 0;
+    glGetQueryObjectiv(mQueries[previous][last], GL_QUERY_RESULT_AVAILABLE,
+                       &available);
+    // The first frame is only read to be discarded: llvmpipe reports the
+    // time since the context was created for the very first query
+    bool keep = available && mCollected;
+    mCollected |= available != 0;
+    for (int i = 0; keep && i <= last; i++) {
+      if (!mIssued[previous][i]) {
+        continue;
+      }
+      GLuint64 elapsed = 0;
+      glGetQueryObjectui64v(mQueries[previous][i], GL_QUERY_RESULT, &elapsed);
+      mSamples[i][mSampleIndex[i]] = static_cast<double>(elapsed) / 1.0e6;
+      mSampleIndex[i] = (mSampleIndex[i] + 1) % SAMPLES;
+      mSampleCount[i] = std::min(mSampleCount[i] + 1, SAMPLES);
+    }
+  }
+
+  // The next frame reuses the set just read
+  std::fill(mIssued[previous], mIssued[previous] + PASS_COUNT, false);
+  mSet = previous;
+}
+
+GPUTimer::Stats GPUTimer::GetStats(GPUPass pass) const {
+  Stats stats;
+  int index = static_cast<int>(pass);
+  int count = mSampleCount[index];
+  if (count == 0) {
+    return stats;
+  }
+
+  double sum = 0.0;
+  stats.samples = static_cast<size_t>(count);
+  stats.minMs = mSamples[index][0];
+  stats.maxMs = mSamples[index][0];
+  for (int i = 0; i < count; i++) {
+    sum += mSamples[index][i];
+    stats.minMs = std::min(stats.minMs, mSamples[index][i]);
+    stats.maxMs = std::max(stats.maxMs, mSamples[index][i]);
+  }
+  stats.meanMs = sum / count;
+  return stats;
+}
+
+bool GPUTimer::WriteCSV(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open " << path << " for writing" << std::endl;
+    return false;
+  }
+
+  file << "pass,samples,min_ms,mean_ms,max_ms\n";
+  for (int i = 0; i < PASS_COUNT; i++) {
+    Stats stats = GetStats(static_cast<GPUPass>(i));
+    file << GetGPUPassName(static_cast<GPUPass>(i)) << "," << stats.samples
+         << "," << stats.minMs << "," << stats.meanMs << "," << stats.maxMs
+         << "\n";
+  }
+  return true;
+}
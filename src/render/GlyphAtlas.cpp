@@ -0,0 +1,199 @@
+#include "render/GlyphAtlas.hpp"
+#include "render/Renderer.hpp"
+#include "render/Texture.hpp"
+#include "render/TextureAtlas.hpp"
+#include <SDL2/SDL_ttf.h>
+#include <algorithm>
+#include <iostream>
+
+// Slots 0-94 are printable ASCII, 95-190 the Latin-1 supplement
+static constexpr unsigned int GLYPH_SLOTS = 191;
+static constexpr int ATLAS_COLUMNS = 16;
+
+static unsigned int SlotCodePoint(int slot) {
+  return slot < 95 ? 32 + slot : 160 + (slot - 95);
+}
+
+// Decodes the code point at text[i] and moves i past it. Malformed bytes
+// decode to themselves
+static unsigned int NextCodePoint(const std::string &text, size_t &i) {
+  unsigned char lead = static_cast<unsigned char>(text[i++]);
+  int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+  unsigned int codePoint = extra == 0 ? lead : lead & (0x3F >> extra);
+  for (int k = 0; k < extra; k++) {
+    if (i >= text.size() || (text[i] & 0xC0) != 0x80) {
+      return lead;
+    }
+    codePoint = (codePoint << 6) | (text[i++] & 0x3F);
+  }
+  return codePoint;
+}
+
+GlyphAtlas::GlyphAtlas()
+    : mAtlas(nullptr), mTextureIndex(-1), mGlyphWidth(0), mGlyphHeight(0),
+      mLineSkip(0) {}
+
+GlyphAtlas::~GlyphAtlas() { delete mAtlas; }
+
+int GlyphAtlas::GetSlot(unsigned int codePoint) const {
+  int slot = -1;
+  if (codePoint >= 32 && codePoint < 127) {
+    slot = static_cast<int>(codePoint - 32);
+  } else if (codePoint >= 160 && codePoint < 256) {
+    slot = static_cast<int>(95 + codePoint - 160);
+  }
+  if (slot >= 0 && mAdvances[slot] >= 0) {
+    return slot;
+  }
+  return mAdvances['?' - 32] >= 0 ? '?' - 32 : -1;
+}
+
+bool GlyphAtlas::Build(const std::string &fontPath, int pointSize,
+                       Renderer *renderer) {
+  if (TTF_Init() == -1) {
+    std::cerr << "TTF_Init failed: " << TTF_GetError() << std::endl;
+    return false;
+  }
+  TTF_Font *font = TTF_OpenFont(fontPath.c_str(), pointSize);
+  if (!font) {
+    std::cerr << "Failed to load font: " << TTF_GetError() << std::endl;
+    TTF_Quit();
+    return false;
+  }
+
+  // Each glyph renders into a cell as tall as the font with the pen at the
+  // left edge, so glyphs only need their advance to be laid out
+  const SDL_Color white = {255, 255, 255, 255};
+  std::vector<SDL_Surface *> glyphs(GLYPH_SLOTS, nullptr);
+  mAdvances.assign(GLYPH_SLOTS, -1);
+  mGlyphWidth = 1;
+  mGlyphHeight = TTF_FontHeight(font);
+  mLineSkip = TTF_FontLineSkip(font);
+  for (unsigned int slot = 0; slot < GLYPH_SLOTS; slot++) {
+    Uint16 codePoint = static_cast<Uint16>(SlotCodePoint(slot));
+    int minX, maxX, minY, maxY, advance;
+    if (TTF_GlyphMetrics(font, codePoint, &minX, &maxX, &minY, &maxY,
+                         &advance) != 0) {
+      continue;
+    }
+    mAdvances[slot] = advance;
+    glyphs[slot] = TTF_RenderGlyph_Blended(font, codePoint, white);
+    if (glyphs[slot]) {
+      mGlyphWidth = std::max(mGlyphWidth, glyphs[slot]->w);
+      mGlyphHeight = std::max(mGlyphHeight, glyphs[slot]->h);
+    }
+  }
+  TTF_CloseFont(font);
+  TTF_Quit();
+
+  // Tile 0 is solid, glyph tiles follow in slot order. Tiles have a
+  // transparent one-texel border, the HUD shader samples inside it
+  int tileWidth = mGlyphWidth + 2;
+  int tileHeight = mGlyphHeight + 2;
+  int rows = (GLYPH_SLOTS + 1 + ATLAS_COLUMNS - 1) / ATLAS_COLUMNS;
+  SDL_Surface *atlasSurface = SDL_CreateRGBSurface(
+      0, tileWidth * ATLAS_COLUMNS, tileHeight * rows, 32, 0x000000FF,
+      0x0000FF00, 0x00FF0000, 0xFF000000);
+  if (!atlasSurface) {
+    std::cerr << "Failed to create glyph atlas surface: " << SDL_GetError()
+              << std::endl;
+    for (auto *glyph : glyphs) {
+      SDL_FreeSurface(glyph);
+    }
+    return false;
+  }
+  SDL_FillRect(atlasSurface, nullptr,
+               SDL_MapRGBA(atlasSurface->format, 0, 0, 0, 0));
+  SDL_Rect solidRect = {0, 0, tileWidth, tileHeight};
+  SDL_FillRect(atlasSurface, &solidRect,
+               SDL_MapRGBA(atlasSurface->format, 255, 255, 255, 255));
+
+  for (unsigned int slot = 0; slot < GLYPH_SLOTS; slot++) {
+    if (!glyphs[slot]) {
+      continue;
+    }
+    int tile = static_cast<int>(slot) + 1;
+    SDL_Rect destRect = {(tile % ATLAS_COLUMNS) * tileWidth + 1,
+                         (tile / ATLAS_COLUMNS) * tileHeight + 1,
+                         glyphs[slot]->w, glyphs[slot]->h};
+    // Copy the coverage as is instead of blending it over the clear color
+    SDL_SetSurfaceBlendMode(glyphs[slot], SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(glyphs[slot], nullptr, atlasSurface, &destRect);
+    SDL_FreeSurface(glyphs[slot]);
+  }
+
+  Texture *texture = new Texture();
+  if (!texture->LoadFromSurface(atlasSurface)) {
+    delete texture;
+    SDL_FreeSurface(atlasSurface);
+    return false;
+  }
+  SDL_FreeSurface(atlasSurface);
+
+  mTextureIndex = renderer->RegisterTexture(texture);
+  mAtlas = new TextureAtlas(mTextureIndex);
+  mAtlas->SetGrid(texture->GetWidth(), texture->GetHeight(), tileWidth,
+                  tileHeight);
+  return true;
+}
+
+void GlyphAtlas::Layout(const std::string &text, const Vector4 &tint,
+                        std::vector<SpriteQuad> &quads, int &width,
+                        int &height) const {
+  // Lines are split at '\n', a trailing newline adds no line
+  size_t lineCount = 1;
+  for (size_t i = 0; i + 1 < text.size(); i++) {
+    lineCount += text[i] == '\n';
+  }
+
+  // First pass measures, the second emits the quads relative to the size
+  width = 0;
+  int lineWidth = 0;
+  for (size_t i = 0; i < text.size();) {
+    unsigned int codePoint = NextCodePoint(text, i);
+    if (codePoint == '\n') {
+      width = std::max(width, lineWidth);
+      lineWidth = 0;
+      continue;
+    }
+    int slot = GetSlot(codePoint);
+    if (slot >= 0) {
+      lineWidth += mAdvances[slot];
+    }
+  }
+  width = std::max(width, lineWidth);
+
+  // Multi-line text centers each line in the font's line skip
+  bool multiLine = text.find('\n') != std::string::npos;
+  height = multiLine ? static_cast<int>(lineCount) * mLineSkip : mGlyphHeight;
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  float glyphWidth = static_cast<float>(mGlyphWidth) / width;
+  float glyphHeight = static_cast<float>(mGlyphHeight) / height;
+  int penX = 0;
+  int lineTop = multiLine ? (mLineSkip - mGlyphHeight) / 2 : 0;
+  for (size_t i = 0; i < text.size();) {
+    unsigned int codePoint = NextCodePoint(text, i);
+    if (codePoint == '\n') {
+      penX = 0;
+      lineTop += mLineSkip;
+      continue;
+    }
+    int slot = GetSlot(codePoint);
+    if (slot < 0) {
+      continue;
+    }
+
+    // Cells are wider than most glyphs, their transparent part is discarded
+    if (codePoint != ' ') {
+      Vector4 rect(static_cast<float>(penX) / width + 0.5f * glyphWidth - 0.5f,
+                   0.5f - static_cast<float>(lineTop) / height -
+                       0.5f * glyphHeight,
+                   glyphWidth, glyphHeight);
+      quads.push_back({rect, tint, slot + 1});
+    }
+    penX += mAdvances[slot];
+  }
+}
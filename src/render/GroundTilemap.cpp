@@ -0,0 +1,51 @@
+#include "render/GroundTilemap.hpp"
+#include <algorithm>
+#include <cmath>
+
+GroundTilemap::GroundTilemap()
+    : mColumns(0), mRows(0), mAtlas(nullptr), mMaterials{}, mLift(0.0f),
+      mDirty(false) {
+  Reset(0, 0, nullptr);
+}
+
+void GroundTilemap::Reset(int columns, int rows, TextureAtlas *atlas) {
+  mColumns = std::max(columns, 0);
+  mRows = std::max(rows, 0);
+  mCells.assign(static_cast<size_t>(mColumns) * mRows,
+                GroundCell{-1, static_cast<int16_t>(GroundKind::Empty)});
+  mAtlas = atlas;
+  mLift = 0.0f;
+  mDirty = true;
+
+  // The colors the ground actors had. Water steps between tiles 51 and 52
+  SetMaterial(GroundKind::Empty, {Color::Black, false, 1, 0.0f, false});
+  SetMaterial(GroundKind::Ground, {Color::White, false, 1, 0.0f, false});
+  SetMaterial(GroundKind::Hole, {Color::Black, true, 1, 0.0f, true});
+  SetMaterial(GroundKind::Water,
+              {Vector3(0.0f, 0.5f, 1.0f), false, 2, 0.25f, true});
+  SetMaterial(GroundKind::MagicWater,
+              {Vector3(0.5f, 0.0f, 1.0f), true, 2, 0.25f, true});
+}
+
+void GroundTilemap::Fill(float x, float z, int sizeX, int sizeZ,
+                         GroundKind kind, int tileIndex) {
+  int firstColumn = static_cast<int>(std::lround(x - (sizeX - 1) * 0.5f));
+  int firstRow = static_cast<int>(std::lround(-z - (sizeZ - 1) * 0.5f));
+  int lastColumn = std::min(firstColumn + sizeX, mColumns);
+  int lastRow = std::min(firstRow + sizeZ, mRows);
+
+  GroundCell cell{static_cast<int16_t>(tileIndex), static_cast<int16_t>(kind)};
+  for (int row = std::max(firstRow, 0); row < lastRow; row++) {
+    for (int column = std::max(firstColumn, 0); column < lastColumn;
+         column++) {
+      mCells[static_cast<size_t>(row) * mColumns + column] = cell;
+    }
+  }
+  mDirty = true;
+}
+
+void GroundTilemap::SetMaterial(GroundKind kind,
+                                const GroundMaterial &material) {
+  mMaterials[static_cast<int>(kind)] = material;
+  mDirty = true;
+}
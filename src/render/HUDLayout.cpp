@@ -0,0 +1,119 @@
+// Layout of the HUD layers, the part of the Renderer's HUD without GL calls
+// (the headless bench links it with its null backend)
+
+#include "Game.hpp"
+#include "UI/Screen/UIScreen.hpp"
+#include "actors/Actor.hpp"
+#include "components/SpriteComponent.hpp"
+#include "render/Renderer.hpp"
+#include <algorithm>
+
+// Lower Z values are drawn first (background), higher Z values drawn last
+// (foreground)
+static bool HUDDrawsBefore(const SpriteComponent *a, const SpriteComponent *b) {
+  return a->GetOwner()->GetPosition().z < b->GetOwner()->GetPosition().z;
+}
+
+size_t Renderer::LayoutHUD(int windowWidth, int windowHeight) {
+  uint32_t stamp = mGame->GetRenderStamp();
+  mHUDGathered.clear();
+  for (auto bucket : mRenderBuckets.GetSpriteBuckets()) {
+    if (!bucket->hud) {
+      continue;
+    }
+    for (auto *spriteComp : bucket->components) {
+      if (spriteComp->GetOwner()->GetRenderStamp() == stamp) {
+        mHUDGathered.push_back(spriteComp);
+      }
+    }
+  }
+
+  // Sort only when a sprite was shown or hidden, or moved in Z. Equal Zs keep
+  // the bucket order
+  if (mHUDGathered != mHUDLastGathered) {
+    mHUDLastGathered.swap(mHUDGathered);
+    mHUDSprites = mHUDLastGathered;
+    std::stable_sort(mHUDSprites.begin(), mHUDSprites.end(), HUDDrawsBefore);
+  } else if (!std::is_sorted(mHUDSprites.begin(), mHUDSprites.end(),
+                             HUDDrawsBefore)) {
+    std::stable_sort(mHUDSprites.begin(), mHUDSprites.end(), HUDDrawsBefore);
+  }
+
+  // Each screen's sprites, in the same order
+  for (auto *layer : mHUDLayers) {
+    layer->sprites.clear();
+  }
+  for (auto *spriteComp : mHUDSprites) {
+    GetHUDLayer(spriteComp->GetScreen())->sprites.push_back(spriteComp);
+  }
+
+  // Layers follow the UI stack, later screens are composited over earlier
+  // ones. Sprites outside of a screen go below them all. The layers of
+  // screens that are gone are released
+  const auto &stack = mGame->GetUIStack();
+  auto stackIndex = [&stack](const HUDLayer *layer) {
+    if (!layer->screen) {
+      return -1;
+    }
+    return static_cast<int>(std::find(stack.begin(), stack.end(),
+                                      layer->screen) -
+                            stack.begin());
+  };
+  for (size_t i = 0; i < mHUDLayers.size();) {
+    HUDLayer *layer = mHUDLayers[i];
+    if (layer->sprites.empty() &&
+        stackIndex(layer) == static_cast<int>(stack.size())) {
+      DestroyHUDLayer(layer);
+      mHUDLayers.erase(mHUDLayers.begin() + i);
+    } else {
+      i++;
+    }
+  }
+  std::stable_sort(mHUDLayers.begin(), mHUDLayers.end(),
+                   [&stackIndex](const HUDLayer *a, const HUDLayer *b) {
+                     return stackIndex(a) < stackIndex(b);
+                   });
+
+  // The setters of a screen's sprites mark it dirty. Sprites outside of a
+  // screen have nothing to mark, their layer is redrawn every frame
+  size_t redraws = 0;
+  for (auto *layer : mHUDLayers) {
+    layer->dirty = !layer->screen || layer->screen->IsHUDDirty() ||
+                   layer->sprites != layer->lastSprites ||
+                   layer->width != windowWidth ||
+                   layer->height != windowHeight;
+    if (!layer->dirty) {
+      continue;
+    }
+    if (layer->screen) {
+      layer->screen->ClearHUDDirty();
+    }
+    layer->lastSprites = layer->sprites;
+    layer->width = windowWidth;
+    layer->height = windowHeight;
+    if (!layer->sprites.empty()) {
+      redraws++;
+    }
+  }
+  return redraws;
+}
+
+Renderer::HUDLayer *Renderer::GetHUDLayer(UIScreen *screen) {
+  for (auto *layer : mHUDLayers) {
+    if (layer->screen == screen) {
+      return layer;
+    }
+  }
+  HUDLayer *layer = new HUDLayer();
+  layer->screen = screen;
+  layer->framebuffer = 0;
+  layer->texture = 0;
+  layer->textureWidth = 0;
+  layer->textureHeight = 0;
+  layer->width = 0;
+  layer->height = 0;
+  layer->dirty = true;
+  layer->range = InstanceRange{0, 0};
+  mHUDLayers.push_back(layer);
+  return layer;
+}
@@ -0,0 +1,176 @@
+#include "render/InstanceStream.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+InstanceStream::InstanceStream()
+    : mUsePersistent(false), mBuffer(0), mFrameBytes(0), mMapped(nullptr),
+      mFrame(0), mHead(0), mFrameStart(0), mLastFrameSize(0), mFences{} {}
+
+InstanceStream::~InstanceStream() { Shutdown(); }
+
+bool InstanceStream::Initialize(size_t frameBytes) {
+  mUsePersistent = GLEW_ARB_buffer_storage;
+  Allocate(frameBytes);
+  if (mBuffer == 0) {
+    std::cerr << "Failed to create the instance stream buffer" << std::endl;
+    return false;
+  }
+
+  std::cout << "Instance stream: " << FRAMES_IN_FLIGHT << " x "
+            << mFrameBytes / 1024 << " KB, "
+            << (IsPersistent() ? "persistently mapped" : "orphaned on wrap")
+            << std::endl;
+  return true;
+}
+
+void InstanceStream::Shutdown() {
+  for (auto &fence : mFences) {
+    if (fence) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  // Deleting a buffer also unmaps it
+  Retire();
+  if (!mRetiredBuffers.empty()) {
+    glDeleteBuffers(static_cast<GLsizei>(mRetiredBuffers.size()),
+                    mRetiredBuffers.data());
+    mRetiredBuffers.clear();
+  }
+}
+
+void InstanceStream::Allocate(size_t frameBytes) {
+  mFrameBytes = frameBytes;
+  GLsizeiptr size = static_cast<GLsizeiptr>(mFrameBytes * FRAMES_IN_FLIGHT);
+
+  // The fences guarded the regions of the previous buffer
+  for (auto &fence : mFences) {
+    if (fence) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  glGenBuffers(1, &mBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+
+  if (mUsePersistent) {
+    const GLbitfield flags =
+        GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    mMapped = static_cast<unsigned char *>(
+        glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+
+    if (!mMapped) {
+      std::cerr << "Persistent instance buffer mapping failed, falling back "
+                   "to orphaning"
+                << std::endl;
+      glBindBuffer(GL_ARRAY_BUFFER, 0);
+      glDeleteBuffers(1, &mBuffer);
+      mBuffer = 0;
+      mUsePersistent = false;
+      Allocate(frameBytes);
+      return;
+    }
+    mFrameStart = mFrame * mFrameBytes;
+  } else {
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    mFrameStart = 0;
+  }
+  mHead = mFrameStart;
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceStream::Retire() {
+  if (mBuffer != 0) {
+    mRetiredBuffers.push_back(mBuffer);
+    mBuffer = 0;
+    mMapped = nullptr;
+  }
+}
+
+void InstanceStream::WaitForFence(int frame) {
+  GLsync fence = mFences[frame];
+  if (!fence) {
+    return;
+  }
+
+  while (true) {
+    GLenum result =
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+    if (result != GL_TIMEOUT_EXPIRED) {
+      break;
+    }
+  }
+  glDeleteSync(fence);
+  mFences[frame] = nullptr;
+}
+
+void InstanceStream::BeginFrame() {
+  if (mUsePersistent) {
+    // Reuse the region of the oldest frame once the GPU has read it
+    mFrame = (mFrame + 1) % FRAMES_IN_FLIGHT;
+    WaitForFence(mFrame);
+    mHead = mFrame * mFrameBytes;
+  } else if (mHead + mLastFrameSize > mFrameBytes * FRAMES_IN_FLIGHT) {
+    // Not enough room left for a frame like the last one: orphan the storage
+    // (the driver keeps the old one for the queued draws) and wrap
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(mFrameBytes * FRAMES_IN_FLIGHT),
+                 nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    mHead = 0;
+  }
+  mFrameStart = mHead;
+}
+
+void InstanceStream::EndFrame() {
+  if (mUsePersistent) {
+    mFences[mFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+  mLastFrameSize = mHead - mFrameStart;
+
+  // The draws of this frame are queued, the driver frees the storage of the
+  // outgrown buffers once they are done
+  if (!mRetiredBuffers.empty()) {
+    glDeleteBuffers(static_cast<GLsizei>(mRetiredBuffers.size()),
+                    mRetiredBuffers.data());
+    mRetiredBuffers.clear();
+  }
+}
+
+InstanceRange InstanceStream::Write(const void *data, size_t bytes) {
+  size_t end = mUsePersistent ? mFrameStart + mFrameBytes
+                              : mFrameBytes * FRAMES_IN_FLIGHT;
+
+  // This frame outgrew the buffer. The ranges written so far stay valid in
+  // the old one, which is kept until the end of the frame
+  if (mHead + bytes > end) {
+    size_t frameSize = mHead - mFrameStart + bytes;
+    Retire();
+    Allocate(std::max(mFrameBytes * 2, frameSize));
+  }
+
+  InstanceRange range{mBuffer, mHead};
+  if (mMapped) {
+    std::memcpy(mMapped + mHead, data, bytes);
+  } else {
+    // The range is not used by any queued draw, so no synchronization
+    glBindBuffer(GL_ARRAY_BUFFER, mBuffer);
+    void *dest = glMapBufferRange(GL_ARRAY_BUFFER, mHead, bytes,
+                                  GL_MAP_WRITE_BIT |
+                                      GL_MAP_INVALIDATE_RANGE_BIT |
+                                      GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dest) {
+      std::memcpy(dest, data, bytes);
+      glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+  }
+  mHead += bytes;
+  return range;
+}
@@ -1,14 +1,18 @@
 #include "render/Mesh.hpp"
+#include "render/GLState.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
 
 // ============== Base Mesh Class ==============
 
 Mesh::Mesh()
-    : mVertexArray(0), mVertexBuffer(0), mIndexBuffer(0), mInstanceBuffer(0),
-      mNumVerts(0), mNumIndices(0), mMaxInstances(0) {}
+    : mVertexArray(0), mVertexBuffer(0), mIndexBuffer(0), mNumVerts(0),
+      mNumIndices(0), mBoundsCenter(Vector3::Zero),
+      mBoundsExtents(Vector3::Zero) {}
 
 Mesh::~Mesh() {
   if (mVertexBuffer != 0) {
@@ -19,13 +23,10 @@ Mesh::~Mesh() {
     glDeleteBuffers(1, &mIndexBuffer);
     mIndexBuffer = 0;
   }
-  if (mInstanceBuffer != 0) {
-    glDeleteBuffers(1, &mInstanceBuffer);
-    mInstanceBuffer = 0;
-  }
   if (mVertexArray != 0) {
     glDeleteVertexArrays(1, &mVertexArray);
     mVertexArray = 0;
+    GLState::Invalidate();
   }
 }
 
@@ -42,10 +43,12 @@ void Mesh::Build(MeshData meshdata) {
   if (mVertexArray != 0) {
     glDeleteVertexArrays(1, &mVertexArray);
     mVertexArray = 0;
+    GLState::Invalidate();
   }
 
-  // Store triangles (for texture mapping)
+  // Store triangles (for texture mapping) and the bounds (for culling)
   mTriangles = meshdata.triangles;
+  ComputeBounds(meshdata.vertices);
 
   // Convert vertices to flat array format: [x, y, z, nx, ny, nz, u, v,
   // texIndex] We'll set texture index per-vertex based on the first triangle
@@ -67,6 +70,10 @@ void Mesh::Build(MeshData meshdata) {
     }
   }
 
+  // Kept for baking
+  mVertices = meshdata.vertices;
+  mVertexTextureIndices = vertexTextureIndices;
+
   // Now build the vertex data
   for (size_t i = 0; i < meshdata.vertices.size(); ++i) {
     const Vertex &vertex = meshdata.vertices[i];
@@ -104,7 +111,7 @@ void Mesh::Build(MeshData meshdata) {
 
   // Create vertex array object
   glGenVertexArrays(1, &mVertexArray);
-  glBindVertexArray(mVertexArray);
+  GLState::BindVertexArray(mVertexArray);
 
   // Create and populate vertex buffer
   glGenBuffers(1, &mVertexBuffer);
@@ -118,6 +125,20 @@ void Mesh::Build(MeshData meshdata) {
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size() * sizeof(unsigned int),
                indexData.data(), GL_STATIC_DRAW);
 
+  BindVertexAttributes();
+
+  // Unbind VAO
+  GLState::BindVertexArray(0);
+
+  std::cout << "Mesh built with " << meshdata.vertices.size()
+            << " vertices and " << meshdata.triangles.size() << " triangles"
+            << std::endl;
+}
+
+void Mesh::BindVertexAttributes() const {
+  glBindBuffer(GL_ARRAY_BUFFER, mVertexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexBuffer);
+
   // Set up vertex attributes (9 floats per vertex with texture index)
   // Position attribute (location = 0)
   glEnableVertexAttribArray(0);
@@ -137,16 +158,9 @@ void Mesh::Build(MeshData meshdata) {
   glEnableVertexAttribArray(3);
   glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, 9 * sizeof(float),
                         (void *)(8 * sizeof(float)));
-
-  // Unbind VAO
-  glBindVertexArray(0);
-
-  std::cout << "Mesh built with " << meshdata.vertices.size()
-            << " vertices and " << meshdata.triangles.size() << " triangles"
-            << std::endl;
 }
 
-void Mesh::SetActive() const { glBindVertexArray(mVertexArray); }
+void Mesh::SetActive() const { GLState::BindVertexArray(mVertexArray); }
 
 bool Mesh::LoadFromFile(const std::string &filename) {
   // Base implementation - to be overridden by derived classes
@@ -782,75 +796,166 @@ MeshData WallMesh::GenerateWallData() {
   return data;
 }
 
-void Mesh::SetupInstanceBuffer(size_t maxInstances) {
-  mMaxInstances = maxInstances;
-
-  if (mInstanceBuffer != 0) {
-    glDeleteBuffers(1, &mInstanceBuffer);
-  }
+void Mesh::SetActive(const InstanceRange &instances) const {
+  GLState::BindVertexArray(mVertexArray);
 
-  // Bind VAO to modify it
-  glBindVertexArray(mVertexArray);
+  // No base instance in GL 3.3, the attributes start at the range instead
+  BindInstanceAttributes(instances.buffer, instances.offset);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-  // Create instance buffer
-  glGenBuffers(1, &mInstanceBuffer);
-  glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
+void Mesh::SetActiveSprites(const InstanceRange &instances) const {
+  GLState::BindVertexArray(mVertexArray);
+  BindSpriteInstanceAttributes(instances.buffer, instances.offset);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-  // Allocate buffer (36 floats per instance: 16 + 16 + 3 + 1)
-  glBufferData(GL_ARRAY_BUFFER, maxInstances * 36 * sizeof(float), nullptr,
-               GL_DYNAMIC_DRAW);
+void Mesh::SetActiveHUD(const InstanceRange &instances) const {
+  GLState::BindVertexArray(mVertexArray);
+  BindHUDInstanceAttributes(instances.buffer, instances.offset);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-  // Setup instance attribute pointers
-  // Model matrix (mat4) - locations 4, 5, 6, 7
-  for (int i = 0; i < 4; i++) {
-    glEnableVertexAttribArray(4 + i);
-    glVertexAttribPointer(4 + i, 4, GL_FLOAT, GL_FALSE, 36 * sizeof(float),
-                          (void *)(i * 4 * sizeof(float)));
-    glVertexAttribDivisor(4 + i, 1); // Advance once per instance
+void Mesh::ComputeBounds(const std::vector<Vertex> &vertices) {
+  if (vertices.empty()) {
+    mBoundsCenter = Vector3::Zero;
+    mBoundsExtents = Vector3::Zero;
+    return;
   }
 
-  // Normal matrix (mat4) - locations 8, 9, 10, 11
-  for (int i = 0; i < 4; i++) {
-    glEnableVertexAttribArray(8 + i);
-    glVertexAttribPointer(8 + i, 4, GL_FLOAT, GL_FALSE, 36 * sizeof(float),
-                          (void *)((16 + i * 4) * sizeof(float)));
-    glVertexAttribDivisor(8 + i, 1); // Advance once per instance
+  Vector3 min = vertices[0].position;
+  Vector3 max = vertices[0].position;
+  for (const auto &vertex : vertices) {
+    min = Vector3(std::min(min.x, vertex.position.x),
+                  std::min(min.y, vertex.position.y),
+                  std::min(min.z, vertex.position.z));
+    max = Vector3(std::max(max.x, vertex.position.x),
+                  std::max(max.y, vertex.position.y),
+                  std::max(max.z, vertex.position.z));
   }
+  mBoundsCenter = (min + max) * 0.5f;
+  mBoundsExtents = (max - min) * 0.5f;
+}
 
-  // Color (vec3) - location 12
-  glEnableVertexAttribArray(12);
-  glVertexAttribPointer(12, 3, GL_FLOAT, GL_FALSE, 36 * sizeof(float),
-                        (void *)(32 * sizeof(float)));
-  glVertexAttribDivisor(12, 1); // Advance once per instance
+unsigned int Mesh::CreateInstanceArray(unsigned int instanceBuffer) const {
+  GLuint vertexArray = 0;
+  glGenVertexArrays(1, &vertexArray);
+  GLState::BindVertexArray(vertexArray);
 
-  // Tile index (float) - location 13
-  glEnableVertexAttribArray(13);
-  glVertexAttribPointer(13, 1, GL_FLOAT, GL_FALSE, 36 * sizeof(float),
-                        (void *)(35 * sizeof(float)));
-  glVertexAttribDivisor(13, 1); // Advance once per instance
+  BindVertexAttributes();
+  BindInstanceAttributes(instanceBuffer);
 
-  // Unbind
-  glBindVertexArray(0);
+  GLState::BindVertexArray(0);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
+  return vertexArray;
 }
 
-void Mesh::UpdateInstanceBuffer(const std::vector<float> &instanceData,
-                                size_t instanceCount) {
-  if (mInstanceBuffer == 0) {
-    std::cerr << "Instance buffer not set up. Call SetupInstanceBuffer first."
-              << std::endl;
-    return;
-  }
+void Mesh::BindInstanceAttributes(unsigned int instanceBuffer,
+                                  size_t offset) {
+  glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+  const GLsizei stride = sizeof(MeshInstance);
+
+  // Position and scale (vec3) - locations 4, 5
+  glEnableVertexAttribArray(4);
+  glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(MeshInstance, position)));
+  glVertexAttribDivisor(4, 1); // Advance once per instance
+
+  glEnableVertexAttribArray(5);
+  glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(MeshInstance, scale)));
+  glVertexAttribDivisor(5, 1);
+
+  // Rotation quaternion (vec4 from normalized shorts) - location 6
+  glEnableVertexAttribArray(6);
+  glVertexAttribPointer(6, 4, GL_SHORT, GL_TRUE, stride,
+                        (void *)(offset + offsetof(MeshInstance, rotation)));
+  glVertexAttribDivisor(6, 1);
+
+  // Color and bloomed flag (vec4 from half floats) - location 7
+  glEnableVertexAttribArray(7);
+  glVertexAttribPointer(7, 4, GL_HALF_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(MeshInstance, color)));
+  glVertexAttribDivisor(7, 1);
+
+  // Tile index (int) - location 8
+  glEnableVertexAttribArray(8);
+  glVertexAttribIPointer(8, 1, GL_INT, stride,
+                         (void *)(offset + offsetof(MeshInstance, tileIndex)));
+  glVertexAttribDivisor(8, 1);
+  // Texture array layer (int) - location 9
+  glEnableVertexAttribArray(9);
+  glVertexAttribIPointer(9, 1, GL_INT, stride,
+                         (void *)(offset + offsetof(MeshInstance, layer)));
+  glVertexAttribDivisor(9, 1);
+}
 
-  if (instanceCount > mMaxInstances) {
-    std::cerr << "Instance count (" << instanceCount
-              << ") exceeds max instances (" << mMaxInstances << ")"
-              << std::endl;
-    return;
-  }
+void Mesh::BindSpriteInstanceAttributes(unsigned int instanceBuffer,
+                                        size_t offset) {
+  glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+  const GLsizei stride = sizeof(SpriteInstance);
+
+  // Position (vec3), size (vec2) and rotation (float) - locations 4, 5, 6
+  glEnableVertexAttribArray(4);
+  glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(SpriteInstance, position)));
+  glVertexAttribDivisor(4, 1);
+
+  glEnableVertexAttribArray(5);
+  glVertexAttribPointer(5, 2, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(SpriteInstance, size)));
+  glVertexAttribDivisor(5, 1);
+
+  glEnableVertexAttribArray(6);
+  glVertexAttribPointer(6, 1, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(SpriteInstance, rotation)));
+  glVertexAttribDivisor(6, 1);
+
+  // Color and bloomed flag (vec4 from half floats) - location 7
+  glEnableVertexAttribArray(7);
+  glVertexAttribPointer(7, 4, GL_HALF_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(SpriteInstance, color)));
+  glVertexAttribDivisor(7, 1);
+
+  // Tile index (int) - location 8
+  glEnableVertexAttribArray(8);
+  glVertexAttribIPointer(
+      8, 1, GL_INT, stride,
+      (void *)(offset + offsetof(SpriteInstance, tileIndex)));
+  glVertexAttribDivisor(8, 1);
+  // Texture array layer (int) - location 9
+  glEnableVertexAttribArray(9);
+  glVertexAttribIPointer(9, 1, GL_INT, stride,
+                         (void *)(offset + offsetof(SpriteInstance, layer)));
+  glVertexAttribDivisor(9, 1);
+}
 
-  glBindBuffer(GL_ARRAY_BUFFER, mInstanceBuffer);
-  glBufferSubData(GL_ARRAY_BUFFER, 0, instanceData.size() * sizeof(float),
-                  instanceData.data());
-  glBindBuffer(GL_ARRAY_BUFFER, 0);
+void Mesh::BindHUDInstanceAttributes(unsigned int instanceBuffer,
+                                     size_t offset) {
+  glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+  const GLsizei stride = sizeof(HUDInstance);
+
+  // Rect (vec4) - location 4
+  glEnableVertexAttribArray(4);
+  glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(HUDInstance, rect)));
+  glVertexAttribDivisor(4, 1);
+
+  // Tint (half float vec4) - location 5
+  glEnableVertexAttribArray(5);
+  glVertexAttribPointer(5, 4, GL_HALF_FLOAT, GL_FALSE, stride,
+                        (void *)(offset + offsetof(HUDInstance, tint)));
+  glVertexAttribDivisor(5, 1);
+
+  // Tile index (int) - location 6
+  glEnableVertexAttribArray(6);
+  glVertexAttribIPointer(6, 1, GL_INT, stride,
+                         (void *)(offset + offsetof(HUDInstance, tileIndex)));
+  glVertexAttribDivisor(6, 1);
+
+  // The quad's vertex array is shared with world sprites, whose remaining
+  // attributes would still point into an old range
+  glDisableVertexAttribArray(7);
+  glDisableVertexAttribArray(8);
+  glDisableVertexAttribArray(9);
 }
@@ -0,0 +1,150 @@
+#include "render/RenderBuckets.hpp"
+#include "actors/Actor.hpp"
+#include "components/MeshComponent.hpp"
+#include "components/SpriteComponent.hpp"
+#include <cmath>
+
+// Swap with the last component of the bucket and pop
+template <typename T> void RenderBuckets::Unfile(T *component) {
+  auto bucket = component->mBucket;
+  if (!bucket) {
+    return;
+  }
+  T *last = bucket->components.back();
+  bucket->components[component->mBucketIndex] = last;
+  last->mBucketIndex = component->mBucketIndex;
+  bucket->components.pop_back();
+  component->mBucket = nullptr;
+}
+
+template <typename T, typename Bucket>
+void RenderBuckets::File(T *component, Bucket *bucket) {
+  if (bucket == component->mBucket) {
+    return;
+  }
+  Unfile(component);
+  if (bucket) {
+    component->mBucket = bucket;
+    component->mBucketIndex = bucket->components.size();
+    bucket->components.push_back(component);
+  }
+}
+
+RenderBuckets::~RenderBuckets() {
+  for (auto bucket : mMeshBuckets) {
+    delete bucket;
+  }
+  for (auto bucket : mSpriteBuckets) {
+    delete bucket;
+  }
+  for (auto chunk : mStaticChunks) {
+    delete chunk;
+  }
+}
+
+void RenderBuckets::Update(MeshComponent *mesh) {
+  // Baked geometry can't follow a change, the mesh is drawn by itself again
+  Unbake(mesh);
+
+  MeshBucket *bucket = nullptr;
+  if (mesh->IsVisible()) {
+    bucket = GetMeshBucket(&mesh->GetMesh(), mesh->IsBloomed(),
+                           mesh->GetOwner()->IsStatic());
+  }
+  File(mesh, bucket);
+}
+
+void RenderBuckets::Update(SpriteComponent *sprite) {
+  SpriteBucket *bucket = nullptr;
+  if (sprite->IsVisible()) {
+    bucket = GetSpriteBucket(sprite->IsBloomed(), sprite->IsHUD());
+  }
+  File(sprite, bucket);
+}
+
+void RenderBuckets::Remove(MeshComponent *mesh) {
+  Unbake(mesh);
+  Unfile(mesh);
+}
+
+void RenderBuckets::Remove(SpriteComponent *sprite) { Unfile(sprite); }
+
+void RenderBuckets::Bake(MeshComponent *mesh, const Vector3 &position) {
+  int x = static_cast<int>(std::floor(position.x / STATIC_CHUNK_SIZE));
+  int z = static_cast<int>(std::floor(position.z / STATIC_CHUNK_SIZE));
+  StaticChunk *chunk = GetStaticChunk(x, z, mesh->IsBloomed());
+  if (chunk == mesh->mChunk) {
+    return;
+  }
+  Unbake(mesh);
+  Unfile(mesh);
+  mesh->mChunk = chunk;
+  mesh->mChunkIndex = chunk->components.size();
+  chunk->components.push_back(mesh);
+  chunk->dirty = true;
+}
+
+void RenderBuckets::Unbake(MeshComponent *mesh) {
+  StaticChunk *chunk = mesh->mChunk;
+  if (!chunk) {
+    return;
+  }
+  MeshComponent *last = chunk->components.back();
+  chunk->components[mesh->mChunkIndex] = last;
+  last->mChunkIndex = mesh->mChunkIndex;
+  chunk->components.pop_back();
+  chunk->dirty = true;
+  mesh->mChunk = nullptr;
+}
+
+MeshBucket *RenderBuckets::GetMeshBucket(Mesh *mesh, bool bloomed,
+                                         bool retained) {
+  for (auto bucket : mMeshBuckets) {
+    if (bucket->mesh == mesh && bucket->bloomed == bloomed &&
+        bucket->retained == retained) {
+      return bucket;
+    }
+  }
+
+  mMeshBuckets.push_back(new MeshBucket{
+      mesh, bloomed, retained, {}, {}, {}, 0, {0, 0}, {}, 0, 0, 0, {}});
+  return mMeshBuckets.back();
+}
+
+SpriteBucket *RenderBuckets::GetSpriteBucket(bool bloomed, bool hud) {
+  for (auto bucket : mSpriteBuckets) {
+    if (bucket->bloomed == bloomed && bucket->hud == hud) {
+      return bucket;
+    }
+  }
+
+  mSpriteBuckets.push_back(
+      new SpriteBucket{bloomed, hud, {}, {}, {}, 0, {0, 0}});
+  return mSpriteBuckets.back();
+}
+
+StaticChunk *RenderBuckets::GetStaticChunk(int x, int z, bool bloomed) {
+  auto &chunks = mStaticChunkMaps[bloomed ? 1 : 0];
+  uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+                 static_cast<uint32_t>(z);
+  auto it = chunks.find(key);
+  if (it != chunks.end()) {
+    return it->second;
+  }
+
+  StaticChunk *chunk = new StaticChunk{x,
+                                       z,
+                                       bloomed,
+                                       {},
+                                       false,
+                                       false,
+                                       Vector3::Zero,
+                                       Vector3::Zero,
+                                       0,
+                                       0,
+                                       0,
+                                       0};
+  mStaticChunks.push_back(chunk);
+  chunks[key] = chunk;
+  return chunk;
+}
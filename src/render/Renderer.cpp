@@ -2,6 +2,8 @@
 #include "AssetLoader.hpp"
 #include "actors/Actor.hpp"
 #include "Game.hpp"
+#include "render/GLState.hpp"
+#include "render/GlyphAtlas.hpp"
 #include "render/Mesh.hpp"
 #include "components/MeshComponent.hpp"
 #include "render/Shader.hpp"
@@ -9,20 +11,128 @@
 #include "render/TextureAtlas.hpp"
 #include <GL/glew.h>
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
 
+// Float to half float, for instance colors (no denormals, flushed to zero)
+static uint16_t ToHalf(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  int exponent = static_cast<int>((bits >> 23) & 0xff) - 127 + 15;
+  uint32_t mantissa = bits & 0x7fffff;
+  if (exponent <= 0) {
+    return sign;
+  }
+  if (exponent >= 31) {
+    return sign | 0x7c00;
+  }
+
+  // Round to nearest, a carry moves into the exponent
+  uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+  if (mantissa & 0x1000) {
+    half++;
+  }
+  return sign | static_cast<uint16_t>(half);
+}
+
+static int16_t ToSnorm16(float value) {
+  value = std::max(-1.0f, std::min(1.0f, value));
+  return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+static void PackColor(uint16_t color[4], const Vector3 &rgb, bool bloomed) {
+  color[0] = ToHalf(rgb.x);
+  color[1] = ToHalf(rgb.y);
+  color[2] = ToHalf(rgb.z);
+  color[3] = ToHalf(bloomed ? 1.0f : 0.0f);
+}
+
+// Packs a transform and draw state into the compact instance layout
+static void PackInstance(MeshInstance &instance, const Vector3 &position,
+                         const Vector3 &scale, const Quaternion &rotation,
+                         const Vector3 &color, bool bloomed, int tileIndex,
+                         int layer) {
+  instance.position[0] = position.x;
+  instance.position[1] = position.y;
+  instance.position[2] = position.z;
+  instance.scale[0] = scale.x;
+  instance.scale[1] = scale.y;
+  instance.scale[2] = scale.z;
+  instance.rotation[0] = ToSnorm16(rotation.x);
+  instance.rotation[1] = ToSnorm16(rotation.y);
+  instance.rotation[2] = ToSnorm16(rotation.z);
+  instance.rotation[3] = ToSnorm16(rotation.w);
+  PackColor(instance.color, color, bloomed);
+  instance.tileIndex = tileIndex;
+  instance.layer = layer;
+}
+
+// HUD quad in normalized device coordinates
+static HUDInstance PackHUDInstance(const Vector3 &center, const Vector3 &size,
+                                   const Vector4 &tint, int tileIndex) {
+  HUDInstance instance;
+  instance.rect[0] = center.x;
+  instance.rect[1] = center.y;
+  instance.rect[2] = size.x;
+  instance.rect[3] = size.y;
+  instance.tint[0] = ToHalf(tint.x);
+  instance.tint[1] = ToHalf(tint.y);
+  instance.tint[2] = ToHalf(tint.z);
+  instance.tint[3] = ToHalf(tint.w);
+  instance.tileIndex = tileIndex;
+  return instance;
+}
+
+// Axis-aligned box around a mesh's bounds after scale, rotation and
+// translation
+static void TransformBounds(const Mesh &mesh, const Vector3 &position,
+                            const Vector3 &scale, const Quaternion &rotation,
+                            Vector3 &center, Vector3 &extents) {
+  Vector3 localExtents = mesh.GetBoundsExtents() *
+                         Vector3(std::fabs(scale.x), std::fabs(scale.y),
+                                 std::fabs(scale.z));
+  center =
+      Vector3::Transform(mesh.GetBoundsCenter() * scale, rotation) + position;
+
+  // Each world axis gets the projections of the rotated local extents
+  Matrix4 rotationMatrix = Matrix4::CreateFromQuaternion(rotation);
+  float world[3];
+  for (int col = 0; col < 3; col++) {
+    world[col] = std::fabs(rotationMatrix.mat[0][col]) * localExtents.x +
+                 std::fabs(rotationMatrix.mat[1][col]) * localExtents.y +
+                 std::fabs(rotationMatrix.mat[2][col]) * localExtents.z;
+  }
+  extents = Vector3(world[0], world[1], world[2]);
+}
+
+// Issues an instanced draw of the active mesh
+static void DrawInstanced(const Mesh *mesh, size_t instanceCount) {
+  glDrawElementsInstanced(GL_TRIANGLES, mesh->GetNumIndices(), GL_UNSIGNED_INT,
+                          nullptr, static_cast<GLsizei>(instanceCount));
+}
+
 Renderer::Renderer(Game *game)
     : mGame(game), mViewMatrix(Matrix4::Identity),
       mProjectionMatrix(Matrix4::Identity), mMeshShader(nullptr),
-      mSpriteShader(nullptr), mFramebufferShader(nullptr), mHUDShader(nullptr),
-      mBloomBlurShader(nullptr), mSpriteQuad(nullptr), mScreenQuad(nullptr),
-      mFramebuffer(0), mFramebufferTexture(0), mFramebufferDepthStencil(0),
-      mFramebufferWidth(480), mFramebufferHeight(270), mBloomFramebuffer(0),
-      mBloomTexture(0), mBloomDepthStencil(0), mBlurTexture1(0),
-      mBlurTexture2(0), mBlurFramebuffer1(0), mBlurFramebuffer2(0),
-      mIsDark(true), mLightDir(Vector3(1.0f, -1.0f, 0.5f)),
-      mLightColor(Vector3::One), mAmbientColor(Vector3::One),
-      mBackgroundColor(Vector3::One) {}
+      mBakedShader(nullptr), mGroundShader(nullptr), mSpriteShader(nullptr),
+      mFramebufferShader(nullptr), mHUDShader(nullptr),
+      mBloomDownShader(nullptr), mBloomUpShader(nullptr), mTextureArray(0),
+      mTextureArrayLayers(0), mSpriteQuad(nullptr), mScreenQuad(nullptr),
+      mInstanceStream(nullptr), mGPUTimer(nullptr), mFramebuffer(0),
+      mFramebufferTexture(0), mFramebufferDepthStencil(0),
+      mFramebufferWidth(480), mFramebufferHeight(270), mBloomTexture(0),
+      mBloomLevels(3), mHasBloom(false), mIsDark(true),
+      mLightDir(Vector3(1.0f, -1.0f, 0.5f)), mLightColor(Vector3::One),
+      mAmbientColor(Vector3::One), mBackgroundColor(Vector3::One),
+      mHUDCompositeRange{0, 0}, mHUDDraws(0), mHUDRedraws(0),
+      mInstanceUploadBytes(0), mStaticChunkCount(0), mStaticChunkDraws(0),
+      mGroundCellTexture(0), mGroundVertexArray(0), mGroundVertexBuffer(0),
+      mGroundIndexBuffer(0), mGroundLayer(0), mStateCalls(0),
+      mStateCallsSkipped(0) {}
 
 void Renderer::setNight() {
   mBackgroundColor = Vector3(0.05f, 0.05f, 0.2f);
@@ -53,40 +163,33 @@ Renderer::~Renderer() {
   if (mFramebufferTexture) {
     glDeleteTextures(1, &mFramebufferTexture);
   }
-  if (mFramebufferDepthStencil) {
-    glDeleteRenderbuffers(1, &mFramebufferDepthStencil);
-  }
-
-  // Delete bloom framebuffer objects
-  if (mBloomFramebuffer) {
-    glDeleteFramebuffers(1, &mBloomFramebuffer);
-  }
   if (mBloomTexture) {
     glDeleteTextures(1, &mBloomTexture);
   }
-  if (mBloomDepthStencil) {
-    glDeleteRenderbuffers(1, &mBloomDepthStencil);
-  }
-
-  // Delete blur framebuffer objects
-  if (mBlurFramebuffer1) {
-    glDeleteFramebuffers(1, &mBlurFramebuffer1);
-  }
-  if (mBlurFramebuffer2) {
-    glDeleteFramebuffers(1, &mBlurFramebuffer2);
-  }
-  if (mBlurTexture1) {
-    glDeleteTextures(1, &mBlurTexture1);
+  if (mFramebufferDepthStencil) {
+    glDeleteRenderbuffers(1, &mFramebufferDepthStencil);
   }
-  if (mBlurTexture2) {
-    glDeleteTextures(1, &mBlurTexture2);
+  if (mTextureArray) {
+    glDeleteTextures(1, &mTextureArray);
   }
+  GLState::Invalidate();
+
+  // Delete the bloom mip chain
+  DestroyBloomMips();
 
   // Delete shaders
   if (mMeshShader) {
     delete mMeshShader;
     mMeshShader = nullptr;
   }
+  if (mBakedShader) {
+    delete mBakedShader;
+    mBakedShader = nullptr;
+  }
+  if (mGroundShader) {
+    delete mGroundShader;
+    mGroundShader = nullptr;
+  }
   if (mSpriteShader) {
     delete mSpriteShader;
     mSpriteShader = nullptr;
@@ -99,9 +202,13 @@ Renderer::~Renderer() {
     delete mHUDShader;
     mHUDShader = nullptr;
   }
-  if (mBloomBlurShader) {
-    delete mBloomBlurShader;
-    mBloomBlurShader = nullptr;
+  if (mBloomDownShader) {
+    delete mBloomDownShader;
+    mBloomDownShader = nullptr;
+  }
+  if (mBloomUpShader) {
+    delete mBloomUpShader;
+    mBloomUpShader = nullptr;
   }
 
   // Delete sprite quad
@@ -124,6 +231,13 @@ Renderer::~Renderer() {
 }
 
 bool Renderer::Initialize(float width, float height) {
+  // Nothing is known about the state of a new context
+  GLState::Invalidate();
+
+  // Without timer queries the passes just aren't timed
+  mGPUTimer = new GPUTimer();
+  mGPUTimer->Initialize();
+
   // Make sure we can create/compile shaders
   if (!LoadShaders()) {
     std::cerr << "Failed to load shaders." << std::endl;
@@ -136,29 +250,33 @@ bool Renderer::Initialize(float width, float height) {
   // Create screen quad for framebuffer rendering
   CreateScreenQuad();
 
-  // Create framebuffer for render-to-texture
-  CreateFramebuffer();
+  // Ring buffer for the instances of every dynamic draw, 1 MB per frame to
+  // start with (it grows as needed)
+  mInstanceStream = new InstanceStream();
+  if (!mInstanceStream->Initialize(1024 * 1024)) {
+    return false;
+  }
 
-  // Create bloom framebuffer for bright objects
-  CreateBloomFramebuffer();
+  // Create framebuffer for render-to-texture (scene and bloom targets)
+  CreateFramebuffer();
 
-  // Create blur textures for ping-pong blur
-  CreateBlurTextures();
+  // Create the downsampled levels for the bloom blur
+  CreateBloomMips();
 
   // Set the clear color to background color
   glClearColor(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z,
                1.0f);
 
   // Enable depth testing
-  glEnable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
 
   // Enable backface culling
-  glEnable(GL_CULL_FACE);
+  GLState::SetEnabled(GL_CULL_FACE, true);
   glCullFace(GL_BACK); // Cull back faces
   glFrontFace(GL_CCW); // Counter-clockwise winding is front-facing
 
   // Enable alpha blending
-  glEnable(GL_BLEND);
+  GLState::SetEnabled(GL_BLEND, true);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
   // Set default projection matrix based on framebuffer size (orthographic)
@@ -182,10 +300,47 @@ bool Renderer::Initialize(float width, float height) {
 }
 
 void Renderer::Shutdown() {
+  // Delete the buffers of the retained buckets
+  for (auto bucket : mRenderBuckets.GetMeshBuckets()) {
+    if (bucket->vertexArray) {
+      glDeleteVertexArrays(1, &bucket->vertexArray);
+      bucket->vertexArray = 0;
+      GLState::Invalidate();
+    }
+    if (bucket->instanceBuffer) {
+      glDeleteBuffers(1, &bucket->instanceBuffer);
+      bucket->instanceBuffer = 0;
+    }
+  }
+  for (auto chunk : mRenderBuckets.GetStaticChunks()) {
+    DestroyChunkBuffers(chunk);
+  }
+  DestroyGroundBuffers();
+
+  if (mInstanceStream) {
+    delete mInstanceStream;
+    mInstanceStream = nullptr;
+  }
+  if (mGPUTimer) {
+    delete mGPUTimer;
+    mGPUTimer = nullptr;
+  }
+
+  for (auto *layer : mHUDLayers) {
+    DestroyHUDLayer(layer);
+  }
+  mHUDLayers.clear();
+
   // Unload shaders
   if (mMeshShader) {
     mMeshShader->Unload();
   }
+  if (mBakedShader) {
+    mBakedShader->Unload();
+  }
+  if (mGroundShader) {
+    mGroundShader->Unload();
+  }
   if (mSpriteShader) {
     mSpriteShader->Unload();
   }
@@ -196,6 +351,13 @@ void Renderer::Shutdown() {
       texture->Unload();
     }
   }
+  if (mTextureArray) {
+    glDeleteTextures(1, &mTextureArray);
+    mTextureArray = 0;
+    GLState::Invalidate();
+  }
+  mTextureLayers.clear();
+  mTextureArrayLayers = 0;
 
   // Clear the texture cache
   mTextureCache.clear();
@@ -211,6 +373,10 @@ void Renderer::Shutdown() {
     delete pair.second;
   }
   mAtlasCache.clear();
+  for (auto &pair : mGlyphAtlasCache) {
+    delete pair.second;
+  }
+  mGlyphAtlasCache.clear();
 
   // Delete sprite quad
   if (mSpriteQuad) {
@@ -224,143 +390,759 @@ void Renderer::Clear() {
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Renderer::DrawMeshesInstanced(const std::vector<MeshComponent *> &meshes,
-                                   RendererMode mode) {
-  if (meshes.empty() || !mMeshShader) {
-    return;
+void Renderer::PrepareBuckets() {
+  uint32_t stamp = mGame->GetRenderStamp();
+  mInstanceUploadBytes = 0;
+  mInstanceStream->BeginFrame();
+  mMeshCullStats = CullStats();
+  mSpriteCullStats = CullStats();
+  mHasBloom = false;
+
+  // Only drawn instances reach the bloom target, so the blur runs when a
+  // bloomed one is left after culling
+  const Frustum &frustum = mGame->GetCamera()->GetFrustum();
+
+  // Static chunks: rebake the ones that changed, cull each as a whole
+  mStaticChunkCount = 0;
+  mStaticChunkDraws = 0;
+  for (auto chunk : mRenderBuckets.GetStaticChunks()) {
+    if (chunk->dirty) {
+      BakeChunk(chunk);
+    }
+    chunk->visible =
+        chunk->indexCount > 0 &&
+        frustum.Intersects(chunk->boundsCenter, chunk->boundsExtents);
+    mStaticChunkCount += chunk->indexCount > 0;
+    mStaticChunkDraws += chunk->visible;
+    mHasBloom |= chunk->bloomed && chunk->visible;
   }
 
-  // Group meshes by their mesh pointer and texture atlas
-  struct MeshGroup {
-    Mesh *mesh;
-    TextureAtlas *atlas;
-    int textureIndex;
-    std::vector<MeshComponent *> components;
-  };
+  // The ground tilemap, culled per chunk like the static ones
+  if (mGroundTilemap.IsDirty()) {
+    BuildGroundTilemap();
+  }
+  for (auto &chunk : mGroundChunks) {
+    chunk.visible = frustum.Intersects(chunk.boundsCenter, chunk.boundsExtents);
+    mHasBloom |= chunk.bloomed && chunk.visible;
+  }
+
+  Vector3 center, extents;
+  for (auto bucket : mRenderBuckets.GetMeshBuckets()) {
+    if (bucket->retained) {
+      PrepareRetainedBucket(bucket, stamp);
+      CullRetainedBucket(bucket, frustum);
+      mHasBloom |= bucket->bloomed && !bucket->visibleRuns.empty();
+      continue;
+    }
 
-  std::vector<MeshGroup> groups;
+    bucket->instanceData.resize(bucket->components.size());
+    bucket->bounds.Resize(bucket->components.size());
+    size_t count = 0;
+    for (auto *meshComp : bucket->components) {
+      if (meshComp->GetOwner()->GetRenderStamp() == stamp) {
+        WriteMeshInstance(meshComp, bucket->instanceData[count], center,
+                          extents);
+        bucket->bounds.Set(count, center, extents);
+        count++;
+      }
+    }
+    bucket->instanceCount = CullInstances(frustum, bucket->bounds,
+                                          bucket->instanceData, count,
+                                          mMeshCullStats);
+    StreamInstances(bucket->instanceData.data(), bucket->instanceCount,
+                    bucket->instances);
+    mHasBloom |= bucket->bloomed && bucket->instanceCount > 0;
+  }
 
-  // Group meshes
-  for (auto *meshComp : meshes) {
-    if (!meshComp->IsVisible())
+  for (auto bucket : mRenderBuckets.GetSpriteBuckets()) {
+    bucket->instanceCount = 0;
+    if (bucket->hud) {
       continue;
+    }
 
-    Mesh *mesh = &meshComp->GetMesh();
-    TextureAtlas *atlas = meshComp->GetTextureAtlas();
-    int texIndex = atlas ? atlas->GetTextureIndex() : -1;
-
-    // Find or create group
-    bool found = false;
-    for (auto &group : groups) {
-      if (group.mesh == mesh && group.atlas == atlas &&
-          group.textureIndex == texIndex) {
-        group.components.push_back(meshComp);
-        found = true;
-        break;
+    bucket->instanceData.resize(bucket->components.size());
+    bucket->bounds.Resize(bucket->components.size());
+    size_t count = 0;
+    for (auto *spriteComp : bucket->components) {
+      if (spriteComp->GetOwner()->GetRenderStamp() == stamp) {
+        WriteSpriteInstance(spriteComp, bucket->instanceData[count], center,
+                            extents);
+        bucket->bounds.Set(count, center, extents);
+        count++;
       }
     }
+    bucket->instanceCount = CullInstances(frustum, bucket->bounds,
+                                          bucket->instanceData, count,
+                                          mSpriteCullStats);
+    StreamInstances(bucket->instanceData.data(), bucket->instanceCount,
+                    bucket->instances);
+    mHasBloom |= bucket->bloomed && bucket->instanceCount > 0;
+  }
+
+  PrepareHUD();
+
+  // Textures first used this frame
+  if (mTextureLayers.size() != mTextureArrayLayers) {
+    UpdateTextureArray();
+  }
+}
 
-    if (!found) {
-      groups.push_back({mesh, atlas, texIndex, {meshComp}});
+void Renderer::PrepareHUD() {
+  int windowWidth, windowHeight;
+  SDL_GL_GetDrawableSize(SDL_GL_GetCurrentWindow(), &windowWidth,
+                         &windowHeight);
+  LayoutHUD(windowWidth, windowHeight);
+
+  // Only the layers to redraw are packed again, the others keep the instances
+  // their texture was drawn from
+  bool anyDrawn = false;
+  for (auto *layer : mHUDLayers) {
+    anyDrawn |= !layer->sprites.empty();
+    if (!layer->dirty) {
+      continue;
     }
+
+    layer->instances.clear();
+    layer->runs.clear();
+    for (auto *spriteComp : layer->sprites) {
+      TextureAtlas *atlas = spriteComp->GetTextureAtlas();
+      int textureIndex = spriteComp->GetTextureIndex();
+
+      // Position is already in normalized screen coordinates, scale is a
+      // fraction of the screen (1.0 = full width/height). The owner's Z only
+      // orders the draws
+      Vector3 screenPos =
+          spriteComp->GetOwner()->GetPosition() + spriteComp->GetOffset();
+      Vector3 scale =
+          spriteComp->GetOwner()->GetScale() * spriteComp->GetScale();
+      Vector3 color = spriteComp->GetColor();
+
+      // Consecutive sprites with the same texture share a draw
+      if (layer->runs.empty() || layer->runs.back().atlas != atlas ||
+          layer->runs.back().textureIndex != textureIndex) {
+        layer->runs.push_back(
+            {atlas, textureIndex, layer->instances.size(), 0});
+      }
+
+      const auto &quads = spriteComp->GetQuads();
+      if (quads.empty()) {
+        Vector4 tint(color.x, color.y, color.z, 1.0f);
+        int tileIndex = atlas ? spriteComp->GetCurrentTileIndex() : -1;
+        layer->instances.push_back(
+            PackHUDInstance(screenPos, scale, tint, tileIndex));
+      }
+      // Text and other multi-quad sprites: the quads are placed in the
+      // sprite's rect
+      for (const auto &quad : quads) {
+        Vector3 center(screenPos.x + quad.rect.x * scale.x,
+                       screenPos.y + quad.rect.y * scale.y, 0.0f);
+        Vector3 size(quad.rect.z * scale.x, quad.rect.w * scale.y, 0.0f);
+        Vector4 tint(quad.tint.x * color.x, quad.tint.y * color.y,
+                     quad.tint.z * color.z, quad.tint.w);
+        layer->instances.push_back(
+            PackHUDInstance(center, size, tint, atlas ? quad.tileIndex : -1));
+      }
+      layer->runs.back().count =
+          layer->instances.size() - layer->runs.back().first;
+    }
+    if (!layer->instances.empty()) {
+      StreamInstances(layer->instances.data(), layer->instances.size(),
+                      layer->range);
+    }
+  }
+
+  // Layers are composited with one quad over the whole window. The texture's
+  // first row is the bottom one, the quad is flipped
+  if (anyDrawn) {
+    HUDInstance composite =
+        PackHUDInstance(Vector3::Zero, Vector3(2.0f, -2.0f, 0.0f),
+                        Vector4(1.0f, 1.0f, 1.0f, 1.0f), -1);
+    StreamInstances(&composite, 1, mHUDCompositeRange);
+  }
+}
+
+bool Renderer::ResizeHUDLayer(HUDLayer *layer, int width, int height) {
+  if (!layer->framebuffer) {
+    glGenFramebuffers(1, &layer->framebuffer);
+    glGenTextures(1, &layer->texture);
+  }
+  layer->textureWidth = width;
+  layer->textureHeight = height;
+
+  // Drawn 1:1 over the window
+  GLState::BindTexture(0, layer->texture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  GLState::BindFramebuffer(layer->framebuffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         layer->texture, 0);
+  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+    std::cerr << "ERROR: HUD layer framebuffer is not complete!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void Renderer::DestroyHUDLayer(HUDLayer *layer) {
+  if (layer->framebuffer) {
+    glDeleteFramebuffers(1, &layer->framebuffer);
+    glDeleteTextures(1, &layer->texture);
+    GLState::Invalidate();
   }
+  delete layer;
+}
+
+template <typename Instance>
+size_t Renderer::CullInstances(const Frustum &frustum,
+                               const BoundsArray &bounds,
+                               std::vector<Instance> &instances, size_t count,
+                               CullStats &stats) {
+  mCullMask.resize(count);
+  size_t visible = frustum.Cull(bounds, count, mCullMask.data());
+  stats.tested += count;
+  stats.culled += count - visible;
+  stats.drawn += visible;
+
+  // Keep the visible instances, in order
+  if (visible < count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+      if (mCullMask[i]) {
+        instances[kept++] = instances[i];
+      }
+    }
+  }
+  return visible;
+}
 
-  // Draw each group with instancing
-  for (auto &group : groups) {
-    if (group.components.empty())
+void Renderer::CullRetainedBucket(MeshBucket *bucket, const Frustum &frustum) {
+  size_t count = bucket->instanceCount;
+  mCullMask.resize(count);
+  size_t visible = frustum.Cull(bucket->bounds, count, mCullMask.data());
+  mMeshCullStats.tested += count;
+  mMeshCullStats.culled += count - visible;
+  mMeshCullStats.drawn += visible;
+
+  // The buffer stays as uploaded, the visible instances are drawn in runs
+  bucket->visibleRuns.clear();
+  for (size_t i = 0; i < count; i++) {
+    if (!mCullMask[i]) {
       continue;
+    }
+    if (!bucket->visibleRuns.empty() &&
+        bucket->visibleRuns.back().first + bucket->visibleRuns.back().count ==
+            i) {
+      bucket->visibleRuns.back().count++;
+    } else {
+      bucket->visibleRuns.push_back({i, 1});
+    }
+  }
+}
 
-    // Setup instance buffer if not already done
-    if (group.mesh->GetMaxInstances() == 0) {
-      group.mesh->SetupInstanceBuffer(10000); // Max 10k instances per mesh type
+template <typename Instance>
+void Renderer::StreamInstances(const Instance *instances, size_t instanceCount,
+                               InstanceRange &range) {
+  if (instanceCount == 0) {
+    return;
+  }
+  size_t bytes = instanceCount * sizeof(Instance);
+  range = mInstanceStream->Write(instances, bytes);
+  mInstanceUploadBytes += bytes;
+}
+
+void Renderer::PrepareRetainedBucket(MeshBucket *bucket, uint32_t stamp) {
+  const size_t instanceBytes = sizeof(MeshInstance);
+
+  // Rebuild the dirty instances of the components to draw, remembering where
+  // they are in the buffer
+  mDrawnMeshes.clear();
+  mPatchedInstances.clear();
+  for (auto *meshComp : bucket->components) {
+    if (meshComp->GetOwner()->GetRenderStamp() != stamp) {
+      continue;
+    }
+    if (meshComp->mInstanceDirty) {
+      WriteMeshInstance(meshComp, meshComp->mInstance, meshComp->mBoundsCenter,
+                        meshComp->mBoundsExtents);
+      meshComp->mInstanceDirty = false;
+      mPatchedInstances.push_back(mDrawnMeshes.size());
     }
+    mDrawnMeshes.push_back(meshComp);
+  }
+  bucket->instanceCount = mDrawnMeshes.size();
+
+  if (bucket->instanceBuffer == 0) {
+    glGenBuffers(1, &bucket->instanceBuffer);
+    bucket->vertexArray = bucket->mesh->CreateInstanceArray(
+        bucket->instanceBuffer);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, bucket->instanceBuffer);
+
+  // Same components in the same order: only patch the rebuilt instances.
+  // (A component deleted and reallocated at the same address is dirty, so
+  // comparing stale pointers is safe)
+  if (mDrawnMeshes == bucket->uploaded) {
+    for (size_t index : mPatchedInstances) {
+      MeshComponent *meshComp = mDrawnMeshes[index];
+      glBufferSubData(GL_ARRAY_BUFFER, index * instanceBytes, instanceBytes,
+                      &meshComp->mInstance);
+      bucket->bounds.Set(index, meshComp->mBoundsCenter,
+                         meshComp->mBoundsExtents);
+    }
+    mInstanceUploadBytes += mPatchedInstances.size() * instanceBytes;
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return;
+  }
 
-    // Prepare instance data: model matrix (16) + normal matrix (16) + color (3)
-    // + tileIndex (1) = 36 floats per instance
-    std::vector<float> instanceData;
-    instanceData.reserve(group.components.size() * 36);
+  // Otherwise upload all of them (the drawn set changed)
+  bucket->uploaded = mDrawnMeshes;
+  bucket->instanceData.resize(bucket->instanceCount);
+  bucket->bounds.Resize(bucket->instanceCount);
+  for (size_t i = 0; i < mDrawnMeshes.size(); i++) {
+    bucket->instanceData[i] = mDrawnMeshes[i]->mInstance;
+    bucket->bounds.Set(i, mDrawnMeshes[i]->mBoundsCenter,
+                       mDrawnMeshes[i]->mBoundsExtents);
+  }
 
-    for (auto *meshComp : group.components) {
-      Vector3 position = meshComp->GetOffset();
+  size_t bytes = bucket->instanceCount * instanceBytes;
+  if (bucket->instanceCount > bucket->capacity) {
+    bucket->capacity = std::max(bucket->instanceCount, bucket->capacity * 2);
+    glBufferData(GL_ARRAY_BUFFER, bucket->capacity * instanceBytes, nullptr,
+                 GL_STATIC_DRAW);
+  }
+  if (bytes > 0) {
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, bucket->instanceData.data());
+  }
+  mInstanceUploadBytes += bytes;
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-      Vector3 size = meshComp->GetScale();
+// The component's transform (scale, relative rotation, offset) inside the
+// owner's. Exact as long as a relative rotation is not combined with a
+// non-uniform owner scale (that would shear)
+static void GetMeshTransform(MeshComponent *meshComp, Vector3 &position,
+                             Vector3 &scale, Quaternion &rotation) {
+  Vector3 ownerPos = meshComp->GetOwner()->GetRenderPosition();
+  Vector3 ownerScale = meshComp->GetOwner()->GetRenderScale();
+  Quaternion ownerRot = meshComp->GetOwner()->GetRenderRotation();
+
+  position = Vector3::Transform(meshComp->GetOffset() * ownerScale, ownerRot) +
+             ownerPos;
+  scale = meshComp->GetScale() * ownerScale;
+  rotation = Quaternion::Concatenate(meshComp->GetRelativeRotation(), ownerRot);
+}
+
+void Renderer::WriteMeshInstance(MeshComponent *meshComp,
+                                 MeshInstance &instance, Vector3 &boundsCenter,
+                                 Vector3 &boundsExtents) {
+  Vector3 position, scale;
+  Quaternion rotation;
+  GetMeshTransform(meshComp, position, scale, rotation);
+
+  TextureAtlas *atlas = meshComp->GetTextureAtlas();
+  int layer = GetTextureLayer(
+      atlas ? static_cast<int>(atlas->GetTextureIndex()) : -1, atlas);
+  PackInstance(instance, position, scale, rotation, meshComp->GetColor(),
+               meshComp->IsBloomed(), meshComp->GetStartingIndex(), layer);
+  TransformBounds(meshComp->GetMesh(), position, scale, rotation,
+                  boundsCenter, boundsExtents);
+}
 
-      Quaternion rotation = meshComp->GetRelativeRotation();
+void Renderer::BakeStaticGeometry() {
+  // Bake takes the meshes out of the buckets, so they're collected first
+  mDrawnMeshes.clear();
+  for (auto bucket : mRenderBuckets.GetMeshBuckets()) {
+    if (bucket->retained) {
+      mDrawnMeshes.insert(mDrawnMeshes.end(), bucket->components.begin(),
+                          bucket->components.end());
+    }
+  }
+  for (auto *meshComp : mDrawnMeshes) {
+    mRenderBuckets.Bake(meshComp, meshComp->GetOwner()->GetPosition());
+  }
 
-      Vector3 ownerPos = meshComp->GetOwner()->GetPosition();
-      Vector3 ownerScale = meshComp->GetOwner()->GetScale();
-      Quaternion ownerRot = meshComp->GetOwner()->GetRotation();
+  for (auto chunk : mRenderBuckets.GetStaticChunks()) {
+    if (chunk->dirty) {
+      BakeChunk(chunk);
+    }
+  }
+}
 
-      // Model matrix (just transform, not MVP)
-      Matrix4 model = Matrix4::CreateScale(size) *
-                      Matrix4::CreateFromQuaternion(rotation) *
-                      Matrix4::CreateTranslation(position) *
-                      Matrix4::CreateScale(ownerScale) *
-                      Matrix4::CreateFromQuaternion(ownerRot) *
-                      Matrix4::CreateTranslation(ownerPos);
+void Renderer::BakeChunk(StaticChunk *chunk) {
+  chunk->dirty = false;
+  mBakedVertices.clear();
+  mBakedIndices.clear();
 
-      // Add model matrix (16 floats)
-      for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-          instanceData.push_back(model.mat[row][col]);
-        }
+  Vector3 boundsMin, boundsMax, center, extents;
+  for (size_t i = 0; i < chunk->components.size(); i++) {
+    MeshComponent *meshComp = chunk->components[i];
+    const Mesh &mesh = meshComp->GetMesh();
+    Vector3 position, scale;
+    Quaternion rotation;
+    GetMeshTransform(meshComp, position, scale, rotation);
+
+    TextureAtlas *atlas = meshComp->GetTextureAtlas();
+    int layer = GetTextureLayer(
+        atlas ? static_cast<int>(atlas->GetTextureIndex()) : -1, atlas);
+    int startingIndex = meshComp->GetStartingIndex();
+    Vector3 absScale(std::fabs(scale.x), std::fabs(scale.y),
+                     std::fabs(scale.z));
+
+    // What Base.vert does per vertex, once
+    unsigned int base = static_cast<unsigned int>(mBakedVertices.size());
+    const std::vector<Vertex> &vertices = mesh.GetVertices();
+    const std::vector<int> &textureIndices = mesh.GetVertexTextureIndices();
+    for (size_t v = 0; v < vertices.size(); v++) {
+      const Vertex &vertex = vertices[v];
+      Vector3 worldPos =
+          Vector3::Transform(vertex.position * scale, rotation) + position;
+      Vector3 normal = Vector3::Transform(vertex.normal, rotation);
+
+      // UVs scale with the face, so the tile repeats instead of stretching
+      Vector3 aN(std::fabs(vertex.normal.x), std::fabs(vertex.normal.y),
+                 std::fabs(vertex.normal.z));
+      float texU = vertex.texCoord.x *
+                   (aN.x * absScale.z + aN.y * absScale.x + aN.z * absScale.x);
+      float texV = vertex.texCoord.y *
+                   (aN.x * absScale.y + aN.y * absScale.z + aN.z * absScale.y);
+
+      BakedVertex baked;
+      baked.position[0] = worldPos.x;
+      baked.position[1] = worldPos.y;
+      baked.position[2] = worldPos.z;
+      baked.normal[0] = normal.x;
+      baked.normal[1] = normal.y;
+      baked.normal[2] = normal.z;
+      baked.texCoord[0] = texU;
+      baked.texCoord[1] = texV;
+      PackColor(baked.color, meshComp->GetColor(), meshComp->IsBloomed());
+      baked.tileIndex =
+          startingIndex < 0 ? -1 : startingIndex + textureIndices[v];
+      baked.layer = layer;
+      mBakedVertices.push_back(baked);
+    }
+    for (const Triangle &triangle : mesh.GetTriangles()) {
+      for (unsigned int index : triangle.indices) {
+        mBakedIndices.push_back(base + index);
       }
+    }
+
+    TransformBounds(mesh, position, scale, rotation, center, extents);
+    if (i == 0) {
+      boundsMin = center - extents;
+      boundsMax = center + extents;
+    } else {
+      Vector3 low = center - extents;
+      Vector3 high = center + extents;
+      boundsMin = Vector3(std::min(boundsMin.x, low.x),
+                          std::min(boundsMin.y, low.y),
+                          std::min(boundsMin.z, low.z));
+      boundsMax = Vector3(std::max(boundsMax.x, high.x),
+                          std::max(boundsMax.y, high.y),
+                          std::max(boundsMax.z, high.z));
+    }
+  }
+
+  chunk->indexCount = mBakedIndices.size();
+  if (chunk->indexCount == 0) {
+    DestroyChunkBuffers(chunk);
+    return;
+  }
+  chunk->boundsCenter = (boundsMin + boundsMax) * 0.5f;
+  chunk->boundsExtents = (boundsMax - boundsMin) * 0.5f;
+
+  if (chunk->vertexArray == 0) {
+    glGenVertexArrays(1, &chunk->vertexArray);
+    glGenBuffers(1, &chunk->vertexBuffer);
+    glGenBuffers(1, &chunk->indexBuffer);
+    GLState::BindVertexArray(chunk->vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk->vertexBuffer);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk->indexBuffer);
+
+    // Attributes of Baked.vert (see BakedVertex)
+    const GLsizei stride = sizeof(BakedVertex);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void *)offsetof(BakedVertex, position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void *)offsetof(BakedVertex, normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride,
+                          (void *)offsetof(BakedVertex, texCoord));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_HALF_FLOAT, GL_FALSE, stride,
+                          (void *)offsetof(BakedVertex, color));
+    glEnableVertexAttribArray(4);
+    glVertexAttribIPointer(4, 1, GL_INT, stride,
+                           (void *)offsetof(BakedVertex, tileIndex));
+    glEnableVertexAttribArray(5);
+    glVertexAttribIPointer(5, 1, GL_INT, stride,
+                           (void *)offsetof(BakedVertex, layer));
+  } else {
+    GLState::BindVertexArray(chunk->vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk->vertexBuffer);
+  }
+
+  // Rebakes are rare (a static mesh changing leaves its chunk), the buffers
+  // are just respecified
+  glBufferData(GL_ARRAY_BUFFER, mBakedVertices.size() * sizeof(BakedVertex),
+               mBakedVertices.data(), GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+               mBakedIndices.size() * sizeof(unsigned int),
+               mBakedIndices.data(), GL_STATIC_DRAW);
+  GLState::BindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
 
-      // Normal matrix (just rotation)
-      Matrix4 normalMatrix = Matrix4::CreateFromQuaternion(rotation);
+void Renderer::DestroyChunkBuffers(StaticChunk *chunk) {
+  if (chunk->vertexArray) {
+    glDeleteVertexArrays(1, &chunk->vertexArray);
+    glDeleteBuffers(1, &chunk->vertexBuffer);
+    glDeleteBuffers(1, &chunk->indexBuffer);
+    chunk->vertexArray = 0;
+    chunk->vertexBuffer = 0;
+    chunk->indexBuffer = 0;
+    GLState::Invalidate();
+  }
+  chunk->indexCount = 0;
+}
+
+void Renderer::BuildGroundTilemap() {
+  mGroundTilemap.ClearDirty();
+  DestroyGroundBuffers();
+  int columns = mGroundTilemap.GetColumns();
+  int rows = mGroundTilemap.GetRows();
+  if (!mGroundShader || columns == 0 || rows == 0) {
+    return;
+  }
+
+  TextureAtlas *atlas = mGroundTilemap.GetAtlas();
+  mGroundLayer = GetTextureLayer(
+      atlas ? static_cast<int>(atlas->GetTextureIndex()) : -1, atlas);
+
+  // One texel per cell, read with texelFetch
+  const std::vector<GroundCell> &cells = mGroundTilemap.GetCells();
+  glGenTextures(1, &mGroundCellTexture);
+  GLState::BindTexture(1, mGroundCellTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16I, columns, rows, 0, GL_RG_INTEGER,
+               GL_SHORT, cells.data());
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 
-      // Add normal matrix (16 floats)
-      for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-          instanceData.push_back(normalMatrix.mat[row][col]);
+  // The materials are a handful of uniforms
+  mGroundShader->SetActive();
+  mGroundShader->SetIntegerUniform("uGroundLayer", mGroundLayer);
+  std::string name;
+  for (int i = 0; i < static_cast<int>(GroundKind::Count); i++) {
+    const GroundMaterial &material =
+        mGroundTilemap.GetMaterial(static_cast<GroundKind>(i));
+    name = "uGroundColors[" + std::to_string(i) + "]";
+    mGroundShader->SetVectorUniform(
+        name.c_str(),
+        Vector4(material.color.x, material.color.y, material.color.z,
+                material.bloomed ? 1.0f : 0.0f));
+    name = "uGroundAnimations[" + std::to_string(i) + "]";
+    mGroundShader->SetVectorUniform(
+        name.c_str(), Vector4(static_cast<float>(material.frames),
+                              material.frameTime, material.lifted ? 1.0f : 0.0f,
+                              0.0f));
+  }
+
+  // A quad per non-empty cell, chunk by chunk. The cells are read by the
+  // vertex shader, so only emptying or filling a cell needs a rebuild
+  std::vector<GroundVertex> vertices;
+  std::vector<unsigned int> indices;
+  const int chunkSize = static_cast<int>(STATIC_CHUNK_SIZE);
+  const int16_t corners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+  for (int firstRow = 0; firstRow < rows; firstRow += chunkSize) {
+    for (int firstColumn = 0; firstColumn < columns; firstColumn += chunkSize) {
+      GroundChunk chunk{indices.size(), 0, Vector3::Zero, Vector3::Zero,
+                        false, false, false};
+      int minColumn = columns, maxColumn = -1, minRow = rows, maxRow = -1;
+      for (int row = firstRow; row < std::min(firstRow + chunkSize, rows);
+           row++) {
+        for (int column = firstColumn;
+             column < std::min(firstColumn + chunkSize, columns); column++) {
+          const GroundCell &cell =
+              cells[static_cast<size_t>(row) * columns + column];
+          GroundKind kind = static_cast<GroundKind>(cell.kind);
+          if (kind == GroundKind::Empty) {
+            continue;
+          }
+          bool bloomedCell = mGroundTilemap.GetMaterial(kind).bloomed;
+          chunk.bloomed |= bloomedCell;
+          chunk.lit |= !bloomedCell;
+          minColumn = std::min(minColumn, column);
+          maxColumn = std::max(maxColumn, column);
+          minRow = std::min(minRow, row);
+          maxRow = std::max(maxRow, row);
+
+          // Same winding as PlaneMesh
+          unsigned int base = static_cast<unsigned int>(vertices.size());
+          for (const auto &corner : corners) {
+            vertices.push_back({{static_cast<int16_t>(column),
+                                 static_cast<int16_t>(row)},
+                                {corner[0], corner[1]}});
+          }
+          for (unsigned int index : {0u, 2u, 1u, 0u, 3u, 2u}) {
+            indices.push_back(base + index);
+          }
         }
       }
+      chunk.indexCount = indices.size() - chunk.firstIndex;
+      if (chunk.indexCount == 0) {
+        continue;
+      }
+      // Lifted cells rise by less than a unit
+      chunk.boundsCenter = Vector3((minColumn + maxColumn) * 0.5f, 1.0f,
+                                   -(minRow + maxRow) * 0.5f);
+      chunk.boundsExtents = Vector3((maxColumn - minColumn + 1) * 0.5f, 0.5f,
+                                    (maxRow - minRow + 1) * 0.5f);
+      mGroundChunks.push_back(chunk);
+    }
+  }
+  if (indices.empty()) {
+    return;
+  }
+
+  glGenVertexArrays(1, &mGroundVertexArray);
+  glGenBuffers(1, &mGroundVertexBuffer);
+  glGenBuffers(1, &mGroundIndexBuffer);
+  GLState::BindVertexArray(mGroundVertexArray);
+  glBindBuffer(GL_ARRAY_BUFFER, mGroundVertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GroundVertex),
+               vertices.data(), GL_STATIC_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mGroundIndexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int),
+               indices.data(), GL_STATIC_DRAW);
+
+  // Attributes of Ground.vert (see GroundVertex)
+  glEnableVertexAttribArray(0);
+  glVertexAttribIPointer(0, 4, GL_SHORT, sizeof(GroundVertex), nullptr);
+  GLState::BindVertexArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-      // Add color (3 floats)
-      Vector3 color = meshComp->GetColor();
-      instanceData.push_back(color.x);
-      instanceData.push_back(color.y);
-      instanceData.push_back(color.z);
+  if (mGame->IsDebugging()) {
+    std::cout << "Built ground tilemap: " << vertices.size() / 4
+              << " cells in " << mGroundChunks.size() << " chunks" << std::endl;
+  }
+}
+
+void Renderer::DestroyGroundBuffers() {
+  if (mGroundCellTexture) {
+    glDeleteTextures(1, &mGroundCellTexture);
+    mGroundCellTexture = 0;
+  }
+  if (mGroundVertexArray) {
+    glDeleteVertexArrays(1, &mGroundVertexArray);
+    glDeleteBuffers(1, &mGroundVertexBuffer);
+    glDeleteBuffers(1, &mGroundIndexBuffer);
+    mGroundVertexArray = 0;
+    mGroundVertexBuffer = 0;
+    mGroundIndexBuffer = 0;
+  }
+  mGroundChunks.clear();
+  GLState::Invalidate();
+}
+
+void Renderer::DrawMeshBuckets(bool bloomed, RendererMode mode) {
+  if (!mMeshShader) {
+    return;
+  }
+
+  // Set view-projection matrix uniform (same for all instances)
+  Matrix4 viewProj = mViewMatrix * mProjectionMatrix;
+  mMeshShader->SetMatrixUniform("uViewProjection", viewProj);
+
+  // Mesh normals only follow the instance rotation
+  mMeshShader->SetMatrixUniform("uNormalMatrix", Matrix4::Identity);
+
+  // Wireframe for the whole pass
+  GLState::SetPolygonMode(mode == RendererMode::LINES ? GL_LINE : GL_FILL);
+
+  // Every atlas is a layer of the texture array
+  GLState::BindTexture(0, mTextureArray, GL_TEXTURE_2D_ARRAY);
 
-      // Add tile index (1 float)
-      instanceData.push_back(static_cast<float>(meshComp->GetStartingIndex()));
+  mGPUTimer->Begin(bloomed ? GPUPass::BloomedMeshes : GPUPass::Meshes);
+
+  // Static chunks first, one draw each
+  if (mBakedShader && mStaticChunkDraws > 0) {
+    mBakedShader->SetActive();
+    mBakedShader->SetMatrixUniform("uViewProjection", viewProj);
+    for (auto chunk : mRenderBuckets.GetStaticChunks()) {
+      if (chunk->bloomed != bloomed || !chunk->visible) {
+        continue;
+      }
+      GLState::BindVertexArray(chunk->vertexArray);
+      glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(chunk->indexCount),
+                     GL_UNSIGNED_INT, nullptr);
     }
+    mMeshShader->SetActive();
+  }
 
-    // Upload instance data
-    group.mesh->UpdateInstanceBuffer(instanceData, group.components.size());
-
-    // Set view-projection matrix uniform (same for all instances)
-    Matrix4 viewProj = mViewMatrix * mProjectionMatrix;
-    mMeshShader->SetMatrixUniform("uViewProjection", viewProj);
-
-    // Bind texture atlas
-    if (group.atlas && group.textureIndex >= 0 &&
-        group.textureIndex < static_cast<int>(mTextures.size())) {
-      mTextures[group.textureIndex]->Bind(0);
-      mMeshShader->SetIntegerUniform("uTextureAtlas", 0);
-      mMeshShader->SetIntegerUniform("uAtlasColumns",
-                                     group.atlas->GetColumns());
-      mMeshShader->SetVectorUniform("uAtlasTileSize",
-                                    Vector2(group.atlas->GetUVTileSizeX(),
-                                            group.atlas->GetUVTileSizeY()));
+  // The ground, one draw per chunk with cells in this pass
+  if (mGroundShader && !mGroundChunks.empty()) {
+    mGroundShader->SetActive();
+    mGroundShader->SetMatrixUniform("uViewProjection", viewProj);
+    mGroundShader->SetIntegerUniform("uBloomed", bloomed ? 1 : 0);
+    mGroundShader->SetFloatUniform("uGroundLift", mGroundTilemap.GetLift());
+    mGroundShader->SetFloatUniform("uTime", mGame->GetTicksCount() / 1000.0f);
+    GLState::BindTexture(1, mGroundCellTexture);
+    GLState::BindVertexArray(mGroundVertexArray);
+    for (const auto &chunk : mGroundChunks) {
+      if (!chunk.visible || !(bloomed ? chunk.bloomed : chunk.lit)) {
+        continue;
+      }
+      glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(chunk.indexCount),
+                     GL_UNSIGNED_INT,
+                     (void *)(chunk.firstIndex * sizeof(unsigned int)));
     }
+    mMeshShader->SetActive();
+  }
+
+  // Draw each bucket with instancing
+  for (auto bucket : mRenderBuckets.GetMeshBuckets()) {
+    if (bucket->bloomed != bloomed || bucket->instanceCount == 0)
+      continue;
 
-    // Activate mesh VAO
-    group.mesh->SetActive();
+    Mesh *mesh = bucket->mesh;
 
-    // Draw all instances
-    if (mode == RendererMode::LINES) {
-      glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-      glDrawElementsInstanced(GL_TRIANGLES, group.mesh->GetNumIndices(),
-                              GL_UNSIGNED_INT, nullptr,
-                              group.components.size());
-      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    } else {
-      glDrawElementsInstanced(GL_TRIANGLES, group.mesh->GetNumIndices(),
-                              GL_UNSIGNED_INT, nullptr,
-                              group.components.size());
+    // Activate mesh VAO, with the instances uploaded by PrepareBuckets, and
+    // draw the visible ones
+    if (!bucket->retained) {
+      mesh->SetActive(bucket->instances);
+      DrawInstanced(mesh, bucket->instanceCount);
+      continue;
+    }
+    for (const auto &run : bucket->visibleRuns) {
+      // The bucket's own vertex array reads the buffer from the start, other
+      // runs repoint the mesh's
+      if (run.first == 0) {
+        GLState::BindVertexArray(bucket->vertexArray);
+      } else {
+        mesh->SetActive(InstanceRange{bucket->instanceBuffer,
+                                      run.first * sizeof(MeshInstance)});
+      }
+      DrawInstanced(mesh, run.count);
     }
   }
+
+  mGPUTimer->End();
+  GLState::SetPolygonMode(GL_FILL);
+}
+
+GPUTimer::Stats Renderer::GetGPUPassStats(GPUPass pass) const {
+  return mGPUTimer ? mGPUTimer->GetStats(pass) : GPUTimer::Stats();
+}
+
+bool Renderer::WriteGPUPassStats(const std::string &path) const {
+  return mGPUTimer && mGPUTimer->WriteCSV(path);
 }
 
 void Renderer::SetViewMatrix(const Matrix4 &view) { mViewMatrix = view; }
@@ -370,8 +1152,16 @@ void Renderer::SetProjectionMatrix(const Matrix4 &projection) {
 }
 
 void Renderer::Present() {
-  // Buffer swapping is now handled by SDL in main.cpp
-  // This function kept for API compatibility but does nothing
+  // Buffer swapping is handled by SDL in Game::GenerateOutput. The frame's
+  // draws are all queued: fence its streamed instances
+  mInstanceStream->EndFrame();
+  mGPUTimer->EndFrame();
+
+  // GL state calls of the frame (uploads and setup between frames count
+  // towards the next one)
+  mStateCalls = GLState::GetCallCount();
+  mStateCallsSkipped = GLState::GetSkippedCount();
+  GLState::ResetCounters();
 }
 
 bool Renderer::LoadShaders() {
@@ -383,15 +1173,43 @@ bool Renderer::LoadShaders() {
     mMeshShader = nullptr;
     return false;
   }
+  // Samplers read fixed texture units, set once
+  mMeshShader->SetActive();
+  mMeshShader->SetIntegerUniform("uTextureArray", 0);
+
+  // Create the static chunk shader (Baked.vert -> Mesh.frag)
+  mBakedShader = new Shader();
+  if (!mBakedShader->Load(getAssetPath("shaders/Baked.vert"),
+                          getAssetPath("shaders/Mesh.frag"))) {
+    delete mBakedShader;
+    mBakedShader = nullptr;
+    return false;
+  }
+  mBakedShader->SetActive();
+  mBakedShader->SetIntegerUniform("uTextureArray", 0);
 
-  // Create sprite shader (Base.vert -> Sprite.frag)
+  // Create the ground tilemap shader (Ground.vert -> Mesh.frag)
+  mGroundShader = new Shader();
+  if (!mGroundShader->Load(getAssetPath("shaders/Ground.vert"),
+                           getAssetPath("shaders/Mesh.frag"))) {
+    delete mGroundShader;
+    mGroundShader = nullptr;
+    return false;
+  }
+  mGroundShader->SetActive();
+  mGroundShader->SetIntegerUniform("uTextureArray", 0);
+  mGroundShader->SetIntegerUniform("uGroundCells", 1);
+
+  // Create sprite shader (Sprite.vert -> Sprite.frag)
   mSpriteShader = new Shader();
-  if (!mSpriteShader->Load(getAssetPath("shaders/Base.vert"),
+  if (!mSpriteShader->Load(getAssetPath("shaders/Sprite.vert"),
                            getAssetPath("shaders/Sprite.frag"))) {
     delete mSpriteShader;
     mSpriteShader = nullptr;
     return false;
   }
+  mSpriteShader->SetActive();
+  mSpriteShader->SetIntegerUniform("uTextureArray", 0);
 
   // Create framebuffer shader (Framebuffer.vert -> Framebuffer.frag)
   mFramebufferShader = new Shader();
@@ -401,6 +1219,9 @@ bool Renderer::LoadShaders() {
     mFramebufferShader = nullptr;
     return false;
   }
+  mFramebufferShader->SetActive();
+  mFramebufferShader->SetIntegerUniform("uFramebufferTexture", 0);
+  mFramebufferShader->SetIntegerUniform("uBloomTexture", 1);
 
   // Create HUD shader (HUD.vert -> HUD.frag)
   mHUDShader = new Shader();
@@ -410,15 +1231,30 @@ bool Renderer::LoadShaders() {
     mHUDShader = nullptr;
     return false;
   }
+  mHUDShader->SetActive();
+  mHUDShader->SetIntegerUniform("uHUDTexture", 0);
+
+  // Create bloom blur shaders (Framebuffer.vert -> BloomDown/BloomUp.frag).
+  // The kernels are constant, only the source texture unit is set
+  mBloomDownShader = new Shader();
+  if (!mBloomDownShader->Load(getAssetPath("shaders/Framebuffer.vert"),
+                              getAssetPath("shaders/BloomDown.frag"))) {
+    delete mBloomDownShader;
+    mBloomDownShader = nullptr;
+    return false;
+  }
+  mBloomDownShader->SetActive();
+  mBloomDownShader->SetIntegerUniform("uTexture", 0);
 
-  // Create bloom blur shader (Framebuffer.vert -> Bloom.frag)
-  mBloomBlurShader = new Shader();
-  if (!mBloomBlurShader->Load(getAssetPath("shaders/Framebuffer.vert"),
-                              getAssetPath("shaders/Bloom.frag"))) {
-    delete mBloomBlurShader;
-    mBloomBlurShader = nullptr;
+  mBloomUpShader = new Shader();
+  if (!mBloomUpShader->Load(getAssetPath("shaders/Framebuffer.vert"),
+                            getAssetPath("shaders/BloomUp.frag"))) {
+    delete mBloomUpShader;
+    mBloomUpShader = nullptr;
     return false;
   }
+  mBloomUpShader->SetActive();
+  mBloomUpShader->SetIntegerUniform("uTexture", 0);
 
   return true;
 }
@@ -469,6 +1305,114 @@ int Renderer::GetTextureIndex(Texture *texture) const {
   return -1;
 }
 
+int Renderer::GetTextureLayer(int textureIndex, TextureAtlas *atlas) {
+  if (mTextureLayers.empty()) {
+    mTextureLayers.push_back({-1, nullptr});
+  }
+  if (textureIndex < 0 || textureIndex >= static_cast<int>(mTextures.size())) {
+    return 0;
+  }
+
+  // A handful of textures per level, a linear search is enough
+  for (size_t i = 1; i < mTextureLayers.size(); i++) {
+    if (mTextureLayers[i].textureIndex == textureIndex &&
+        mTextureLayers[i].atlas == atlas) {
+      return static_cast<int>(i);
+    }
+  }
+
+  if (mTextureLayers.size() >= MAX_TEXTURE_LAYERS) {
+    std::cerr << "Texture array is full, texture " << textureIndex
+              << " drawn untextured" << std::endl;
+    return 0;
+  }
+  mTextureLayers.push_back({textureIndex, atlas});
+  return static_cast<int>(mTextureLayers.size() - 1);
+}
+
+void Renderer::UpdateTextureArray() {
+  // Layers are never removed, so the indices in the instances stay valid.
+  // The array is rebuilt at the size of the largest texture
+  int width = 1;
+  int height = 1;
+  for (const auto &layer : mTextureLayers) {
+    if (layer.textureIndex >= 0) {
+      width = std::max(width, mTextures[layer.textureIndex]->GetWidth());
+      height = std::max(height, mTextures[layer.textureIndex]->GetHeight());
+    }
+  }
+
+  GLuint textureArray;
+  glGenTextures(1, &textureArray);
+  GLState::BindTexture(0, textureArray, GL_TEXTURE_2D_ARRAY);
+  glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height,
+               static_cast<GLsizei>(mTextureLayers.size()), 0, GL_RGBA,
+               GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+  // Tile size in the array's UVs and columns of each layer
+  std::vector<Vector4> layerTiles(mTextureLayers.size());
+  std::vector<unsigned char> pixels;
+  for (size_t i = 0; i < mTextureLayers.size(); i++) {
+    const TextureLayer &layer = mTextureLayers[i];
+    if (layer.textureIndex < 0) {
+      // Blank layer: white, tinted by the instance color
+      pixels.assign(static_cast<size_t>(width) * height * 4, 255);
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i),
+                      width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                      pixels.data());
+      layerTiles[i] = Vector4(1.0f, 1.0f, 1.0f, 0.0f);
+      continue;
+    }
+
+    Texture *texture = mTextures[layer.textureIndex];
+    int textureWidth = texture->GetWidth();
+    int textureHeight = texture->GetHeight();
+    pixels.resize(static_cast<size_t>(textureWidth) * textureHeight * 4);
+    GLState::BindTexture(0, texture->GetTextureID());
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    GLState::BindTexture(0, textureArray, GL_TEXTURE_2D_ARRAY);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i),
+                    textureWidth, textureHeight, 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                    pixels.data());
+
+    float scaleX = static_cast<float>(textureWidth) / width;
+    float scaleY = static_cast<float>(textureHeight) / height;
+    if (layer.atlas) {
+      layerTiles[i] = Vector4(layer.atlas->GetUVTileSizeX() * scaleX,
+                              layer.atlas->GetUVTileSizeY() * scaleY,
+                              static_cast<float>(layer.atlas->GetColumns()),
+                              0.0f);
+    } else {
+      layerTiles[i] = Vector4(scaleX, scaleY, 1.0f, 0.0f);
+    }
+  }
+
+  if (mTextureArray) {
+    glDeleteTextures(1, &mTextureArray);
+    GLState::Invalidate();
+  }
+  mTextureArray = textureArray;
+  mTextureArrayLayers = mTextureLayers.size();
+
+  // The layer table is shared by the world shaders
+  std::string name;
+  for (Shader *shader :
+       {mMeshShader, mBakedShader, mGroundShader, mSpriteShader}) {
+    if (!shader) {
+      continue;
+    }
+    shader->SetActive();
+    for (size_t i = 0; i < layerTiles.size(); i++) {
+      name = "uLayerTiles[" + std::to_string(i) + "]";
+      shader->SetVectorUniform(name.c_str(), layerTiles[i]);
+    }
+  }
+}
+
 Mesh *Renderer::LoadMesh(const std::string &meshName) {
   // Check if mesh is already cached
   auto it = mMeshCache.find(meshName);
@@ -522,207 +1466,96 @@ TextureAtlas *Renderer::LoadAtlas(const std::string &atlasPath) {
   return nullptr;
 }
 
-void Renderer::DrawSpritesInstanced(
-    const std::vector<SpriteComponent *> &sprites, RendererMode mode) {
-  if (sprites.empty() || !mSpriteShader || !mSpriteQuad) {
-    return;
-  }
-
-  // Group sprites by texture atlas
-  struct SpriteGroup {
-    TextureAtlas *atlas;
-    int textureIndex;
-    std::vector<SpriteComponent *> components;
-  };
-
-  std::vector<SpriteGroup> groups;
-
-  // Group sprites by atlas
-  for (auto *spriteComp : sprites) {
-    if (!spriteComp->IsVisible())
-      continue;
-
-    TextureAtlas *atlas = spriteComp->GetTextureAtlas();
-    int texIndex =
-        mode == RendererMode::TRIANGLES ? spriteComp->GetTextureIndex() : -1;
-
-    // Find or create group
-    bool found = false;
-    for (auto &group : groups) {
-      if (group.atlas == atlas && group.textureIndex == texIndex) {
-        group.components.push_back(spriteComp);
-        found = true;
-        break;
-      }
-    }
-
-    if (!found) {
-      groups.push_back({atlas, texIndex, {spriteComp}});
-    }
+GlyphAtlas *Renderer::LoadGlyphAtlas(const std::string &fontPath,
+                                     int pointSize) {
+  std::string key = fontPath + ":" + std::to_string(pointSize);
+  auto it = mGlyphAtlasCache.find(key);
+  if (it != mGlyphAtlasCache.end()) {
+    return it->second;
   }
 
-  // Setup sprite quad instance buffer if not already done
-  if (mSpriteQuad->GetMaxInstances() == 0) {
-    mSpriteQuad->SetupInstanceBuffer(100000); // Max 100k sprite instances
+  GlyphAtlas *glyphs = new GlyphAtlas();
+  if (glyphs->Build(fontPath, pointSize, this)) {
+    mGlyphAtlasCache[key] = glyphs;
+    std::cout << "Cached glyph atlas: " << key << std::endl;
+    return glyphs;
   }
 
-  // Draw each group with instancing
-  for (auto &group : groups) {
-    if (group.components.empty())
-      continue;
-
-    // Prepare instance data: model matrix (16) + normal matrix (16) + color (3)
-    // + tileIndex (1) = 36 floats per instance
-    std::vector<float> instanceData;
-    instanceData.reserve(group.components.size() * 36);
-
-    for (auto *spriteComp : group.components) {
-
-      Vector3 position = spriteComp->GetOffset();
-      Vector3 size = spriteComp->GetScale();
-
-      Vector3 ownerPos = spriteComp->GetOwner()->GetPosition();
-      Vector3 ownerScale = spriteComp->GetOwner()->GetScale();
-      float rotation = spriteComp->GetRotation();
-
-      // Create initial model matrix
-      Matrix4 model =
-          Matrix4::CreateScale(Vector3(size.x, size.y, 1.0f)) *
-          Matrix4::CreateTranslation(position) *
-          Matrix4::CreateScale(Vector3(ownerScale.x, ownerScale.y, 1.0f)) *
-          Matrix4::CreateTranslation(ownerPos);
-
-      // Transform to view space
-      Matrix4 modelView = model * mViewMatrix;
-
-      // Billboard effect: strip rotation from modelView, keep only translation
-      // and scale In our row-major matrix: mat[row][col] Row 0 is X-axis, Row 1
-      // is Y-axis, Row 2 is Z-axis, Row 3 is homogeneous
-      Matrix4 billboard = Matrix4::Identity;
-
-      // Apply 2D rotation (around Z-axis in screen space, in view space)
-      // The rotation pivot should be at the bottom of the sprite
-      float cosR = Math::Cos(rotation);
-      float sinR = Math::Sin(rotation);
-      float scaledWidth = size.x * ownerScale.x;
-      float scaledHeight = size.y * ownerScale.y;
-
-      // Rotation around bottom center in view space:
-      // In the quad mesh, the bottom is at Y = -0.5, center at Y = 0.5
-      // So we offset by 0.5 units down, rotate, then offset back up
-
-      // Row 0: X-axis (scaled and rotated)
-      billboard.mat[0][0] = scaledWidth * cosR;
-      billboard.mat[0][1] = scaledWidth * sinR;
-      billboard.mat[0][2] = 0.0f;
-      billboard.mat[0][3] = 0.0f;
-
-      // Row 1: Y-axis (scaled and rotated, with pivot adjustment for bottom
-      // center) The pivot offset compensates for rotating around bottom instead
-      // of center
-      billboard.mat[1][0] = -scaledHeight * sinR;
-      billboard.mat[1][1] = scaledHeight * cosR;
-      billboard.mat[1][2] = 0.0f;
-      billboard.mat[1][3] = scaledHeight * 0.5f * (1.0f - cosR);
-
-      // Row 2: Z-axis (no rotation)
-      billboard.mat[2][0] = 0.0f;
-      billboard.mat[2][1] = 0.0f;
-      billboard.mat[2][2] = 1.0f;
-      billboard.mat[2][3] = 0.0f;
-
-      // Row 3: Translation (from view-transformed position)
-      billboard.mat[3][0] = modelView.mat[3][0];
-      billboard.mat[3][1] = modelView.mat[3][1];
-      billboard.mat[3][2] = modelView.mat[3][2];
-      billboard.mat[3][3] = 1.0f;
-
-      // Add billboard modelView matrix (16 floats)
-      for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-          instanceData.push_back(billboard.mat[row][col]);
-        }
-      }
+  delete glyphs;
+  return nullptr;
+}
 
-      // Normal matrix for sprites (camera-facing)
-      Matrix4 normalMatrix = Matrix4::Identity;
-      normalMatrix.mat[0][0] = mViewMatrix.mat[0][0];
-      normalMatrix.mat[0][1] = mViewMatrix.mat[1][0];
-      normalMatrix.mat[0][2] = mViewMatrix.mat[2][0];
+void Renderer::WriteSpriteInstance(SpriteComponent *spriteComp,
+                                   SpriteInstance &instance,
+                                   Vector3 &boundsCenter,
+                                   Vector3 &boundsExtents) {
+  Vector3 size = spriteComp->GetScale();
+  Vector3 ownerPos = spriteComp->GetOwner()->GetRenderPosition();
+  Vector3 ownerScale = spriteComp->GetOwner()->GetRenderScale();
+
+  // The billboard itself is built by Sprite.vert
+  Vector3 position =
+      spriteComp->GetOffset() * Vector3(ownerScale.x, ownerScale.y, 1.0f) +
+      ownerPos;
+  float width = size.x * ownerScale.x;
+  float height = size.y * ownerScale.y;
+
+  instance.position[0] = position.x;
+  instance.position[1] = position.y;
+  instance.position[2] = position.z;
+  instance.size[0] = width;
+  instance.size[1] = height;
+  instance.rotation = spriteComp->GetRotation();
+  PackColor(instance.color, spriteComp->GetColor(), spriteComp->IsBloomed());
+  instance.tileIndex = spriteComp->GetCurrentTileIndex();
+  instance.layer = GetTextureLayer(spriteComp->GetTextureIndex(),
+                                   spriteComp->GetTextureAtlas());
+
+  // The quad faces the camera at any rotation: bound it by its half diagonal
+  float radius = 0.5f * Math::Sqrt(width * width + height * height);
+  boundsCenter = position;
+  boundsExtents = Vector3(radius, radius, radius);
+}
 
-      normalMatrix.mat[1][0] = mViewMatrix.mat[0][1];
-      normalMatrix.mat[1][1] = mViewMatrix.mat[1][1];
-      normalMatrix.mat[1][2] = mViewMatrix.mat[2][1];
+void Renderer::DrawSpriteBuckets(bool bloomed, RendererMode mode) {
+  if (!mSpriteShader || !mSpriteQuad) {
+    return;
+  }
 
-      normalMatrix.mat[2][0] = mViewMatrix.mat[0][2];
-      normalMatrix.mat[2][1] = mViewMatrix.mat[1][2];
-      normalMatrix.mat[2][2] = mViewMatrix.mat[2][2];
+  // The billboards are expanded in view space
+  mSpriteShader->SetMatrixUniform("uView", mViewMatrix);
+  mSpriteShader->SetMatrixUniform("uProjection", mProjectionMatrix);
 
-      // Add normal matrix (16 floats)
-      for (int row = 0; row < 4; row++) {
-        for (int col = 0; col < 4; col++) {
-          instanceData.push_back(normalMatrix.mat[row][col]);
-        }
-      }
+  // Disable backface culling for sprites (allows flipping with negative
+  // scale)
+  GLState::SetEnabled(GL_CULL_FACE, false);
+  GLState::SetPolygonMode(mode == RendererMode::LINES ? GL_LINE : GL_FILL);
 
-      // Add color (3 floats)
-      Vector3 color = spriteComp->GetColor();
-      instanceData.push_back(color.x);
-      instanceData.push_back(color.y);
-      instanceData.push_back(color.z);
+  // Wireframe sprites are untextured
+  GLState::BindTexture(0, mTextureArray, GL_TEXTURE_2D_ARRAY);
+  mSpriteShader->SetIntegerUniform("uUntextured",
+                                   mode == RendererMode::LINES ? 1 : 0);
 
-      // Add current tile index (handles animation) (1 float)
-      instanceData.push_back(
-          static_cast<float>(spriteComp->GetCurrentTileIndex()));
-    }
+  mGPUTimer->Begin(bloomed ? GPUPass::BloomedSprites : GPUPass::Sprites);
 
-    // Upload instance data
-    mSpriteQuad->UpdateInstanceBuffer(instanceData, group.components.size());
-
-    // Set view-projection (just projection since billboard is already in view
-    // space)
-    mSpriteShader->SetMatrixUniform("uViewProjection", mProjectionMatrix);
-
-    // Bind texture atlas
-    if (group.textureIndex >= 0 &&
-        group.textureIndex < static_cast<int>(mTextures.size())) {
-      mTextures[group.textureIndex]->Bind(0);
-      mSpriteShader->SetIntegerUniform("uTextureAtlas", 0);
-      if (group.atlas) {
-        mSpriteShader->SetIntegerUniform("uAtlasColumns",
-                                         group.atlas->GetColumns());
-        mSpriteShader->SetVectorUniform("uAtlasTileSize",
-                                        Vector2(group.atlas->GetUVTileSizeX(),
-                                                group.atlas->GetUVTileSizeY()));
-      } else {
-        mSpriteShader->SetIntegerUniform("uAtlasColumns", 1);
-        mSpriteShader->SetVectorUniform("uAtlasTileSize", Vector2(1.0f, 1.0f));
-      }
-    }
+  // All textures share the array, the buckets only split bloomed sprites
+  for (auto bucket : mRenderBuckets.GetSpriteBuckets()) {
+    if (bucket->hud || bucket->bloomed != bloomed ||
+        bucket->instanceCount == 0)
+      continue;
 
-    // Activate sprite quad VAO
-    mSpriteQuad->SetActive();
+    // Activate sprite quad VAO with the bucket's streamed instances
+    mSpriteQuad->SetActiveSprites(bucket->instances);
 
-    // Disable backface culling for sprites (allows flipping with negative
-    // scale)
-    glDisable(GL_CULL_FACE);
+    // Draw all visible sprite instances
+    DrawInstanced(mSpriteQuad, bucket->instanceCount);
+  }
 
-    // Draw all sprite instances
-    if (mode == RendererMode::LINES) {
-      glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-      glDrawElementsInstanced(GL_TRIANGLES, mSpriteQuad->GetNumIndices(),
-                              GL_UNSIGNED_INT, nullptr,
-                              group.components.size());
-      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-    } else {
-      glDrawElementsInstanced(GL_TRIANGLES, mSpriteQuad->GetNumIndices(),
-                              GL_UNSIGNED_INT, nullptr,
-                              group.components.size());
-    }
+  mGPUTimer->End();
 
-    // Re-enable backface culling for other geometry
-    glEnable(GL_CULL_FACE);
-  }
+  // Re-enable backface culling for other geometry
+  GLState::SetEnabled(GL_CULL_FACE, true);
+  GLState::SetPolygonMode(GL_FILL);
 }
 
 void Renderer::CreateSpriteQuad() {
@@ -761,26 +1594,35 @@ void Renderer::ActivateMeshShader() {
     return;
   }
 
-  // Activate mesh shader program
-  mMeshShader->SetActive();
+  // Static chunks and the ground are drawn in the same pass, the mesh shader
+  // stays active
+  if (mBakedShader) {
+    SetMeshFrameUniforms(mBakedShader, true); // Default: apply lighting
+  }
+  if (mGroundShader) {
+    SetMeshFrameUniforms(mGroundShader, true);
+  }
+  SetMeshFrameUniforms(mMeshShader, true);
+}
+
+void Renderer::SetMeshFrameUniforms(Shader *shader, bool applyLighting) {
+  shader->SetActive();
 
   // Set frame-level uniforms (uniforms that don't change per mesh)
   Vector3 lightdir = mLightDir;
   lightdir.Normalize();
-  mMeshShader->SetVectorUniform("uDirectionalLightDir", lightdir);
-  mMeshShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
-  mMeshShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mMeshShader->SetIntegerUniform("uBloomPass", 0); // Default: not bloom pass
-  mMeshShader->SetIntegerUniform("uApplyLighting",
-                                 1); // Default: apply lighting
+  shader->SetVectorUniform("uDirectionalLightDir", lightdir);
+  shader->SetVectorUniform("uDirectionalLightColor", mLightColor);
+  shader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
+  shader->SetIntegerUniform("uApplyLighting", applyLighting ? 1 : 0);
 
   // Fog uniforms
   Vector3 cameraPos = mGame->GetCamera()->GetPosition();
-  mMeshShader->SetVectorUniform(
+  shader->SetVectorUniform(
       "uCameraPosition",
       cameraPos - 20.0f * mGame->GetCamera()->GetCameraForward());
-  mMeshShader->SetVectorUniform("uFogColor", mBackgroundColor);
-  mMeshShader->SetFloatUniform("uFogDensity", 0.02f);
+  shader->SetVectorUniform("uFogColor", mBackgroundColor);
+  shader->SetFloatUniform("uFogDensity", 0.02f);
 }
 
 void Renderer::ActivateSpriteShader() {
@@ -795,7 +1637,6 @@ void Renderer::ActivateSpriteShader() {
   // Set frame-level uniforms (uniforms that don't change per sprite)
   mSpriteShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
   mSpriteShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mSpriteShader->SetIntegerUniform("uBloomPass", 0); // Default: not bloom pass
   mSpriteShader->SetIntegerUniform("uApplyLighting",
                                    1); // Default: apply lighting
 
@@ -808,66 +1649,19 @@ void Renderer::ActivateSpriteShader() {
   mSpriteShader->SetFloatUniform("uFogDensity", 0.02f);
 }
 
-void Renderer::ActivateMeshShaderForBloom() {
+void Renderer::ActivateMeshShaderNoLighting() {
   if (!mMeshShader) {
     std::cerr << "Mesh shader not loaded" << std::endl;
     return;
   }
 
-  // Activate mesh shader program
-  mMeshShader->SetActive();
-
-  // Set frame-level uniforms (uniforms that don't change per mesh)
-  Vector3 lightdir = mLightDir;
-  lightdir.Normalize();
-  mMeshShader->SetVectorUniform("uDirectionalLightDir", lightdir);
-  mMeshShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
-  mMeshShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mMeshShader->SetIntegerUniform("uBloomPass", 1); // We're in bloom pass
-}
-
-void Renderer::ActivateSpriteShaderForBloom() {
-  if (!mSpriteShader) {
-    std::cerr << "Sprite shader not loaded" << std::endl;
-    return;
+  if (mBakedShader) {
+    SetMeshFrameUniforms(mBakedShader, false); // No lighting
   }
-
-  // Activate sprite shader program
-  mSpriteShader->SetActive();
-
-  // Set frame-level uniforms (uniforms that don't change per sprite)
-  mSpriteShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
-  mSpriteShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mSpriteShader->SetIntegerUniform("uBloomPass", 1); // We're in bloom pass
-  mSpriteShader->SetIntegerUniform("uApplyLighting",
-                                   0); // No lighting in bloom pass
-}
-
-void Renderer::ActivateMeshShaderNoLighting() {
-  if (!mMeshShader) {
-    std::cerr << "Mesh shader not loaded" << std::endl;
-    return;
+  if (mGroundShader) {
+    SetMeshFrameUniforms(mGroundShader, false);
   }
-
-  // Activate mesh shader program
-  mMeshShader->SetActive();
-
-  // Set frame-level uniforms (uniforms that don't change per mesh)
-  Vector3 lightdir = mLightDir;
-  lightdir.Normalize();
-  mMeshShader->SetVectorUniform("uDirectionalLightDir", lightdir);
-  mMeshShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
-  mMeshShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mMeshShader->SetIntegerUniform("uBloomPass", 0);     // Not bloom pass
-  mMeshShader->SetIntegerUniform("uApplyLighting", 0); // No lighting
-
-  // Fog uniforms
-  Vector3 cameraPos = mGame->GetCamera()->GetPosition();
-  mMeshShader->SetVectorUniform(
-      "uCameraPosition",
-      cameraPos - 20.0f * mGame->GetCamera()->GetCameraForward());
-  mMeshShader->SetVectorUniform("uFogColor", mBackgroundColor);
-  mMeshShader->SetFloatUniform("uFogDensity", 0.02f);
+  SetMeshFrameUniforms(mMeshShader, false);
 }
 
 void Renderer::ActivateSpriteShaderNoLighting() {
@@ -882,7 +1676,6 @@ void Renderer::ActivateSpriteShaderNoLighting() {
   // Set frame-level uniforms (uniforms that don't change per sprite)
   mSpriteShader->SetVectorUniform("uDirectionalLightColor", mLightColor);
   mSpriteShader->SetVectorUniform("uAmbientLightColor", mAmbientColor);
-  mSpriteShader->SetIntegerUniform("uBloomPass", 0);     // Not bloom pass
   mSpriteShader->SetIntegerUniform("uApplyLighting", 0); // No lighting
 
   // Fog uniforms
@@ -894,78 +1687,47 @@ void Renderer::ActivateSpriteShaderNoLighting() {
   mSpriteShader->SetFloatUniform("uFogDensity", 0.02f);
 }
 
-void Renderer::DrawSingleMesh(Mesh *mesh, const Vector3 &position,
-                              const Vector3 &scale,
-                              const Quaternion &rotation) {
-  if (!mesh || !mMeshShader) {
+void Renderer::BeginDebugDraw() {
+  if (!mMeshShader) {
     return;
   }
 
-  // Setup instance buffer if not already done
-  if (mesh->GetMaxInstances() == 0) {
-    mesh->SetupInstanceBuffer(1000); // Setup with reasonable max instances
-  }
-
-  // Disable depth test for debug drawing
-  glDisable(GL_DEPTH_TEST);
-
-  // Activate the mesh VAO
-  mesh->SetActive();
+  // Wireframes on top of everything, not occluding bloom
+  GLState::SetEnabled(GL_DEPTH_TEST, false);
+  GLState::SetPolygonMode(GL_LINE);
+  glColorMaski(1, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
-  // Set polygon mode to wireframe for debug drawing
-  glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-
-  // Set the view-projection matrix
   Matrix4 viewProj = mViewMatrix * mProjectionMatrix;
   mMeshShader->SetMatrixUniform("uViewProjection", viewProj);
+  mMeshShader->SetMatrixUniform("uNormalMatrix", Matrix4::Identity);
 
-  // Build model matrix from position, rotation, and scale
-  // Use the same order as DrawMeshesInstanced
-  Matrix4 model = Matrix4::CreateScale(scale) *
-                  Matrix4::CreateFromQuaternion(rotation) *
-                  Matrix4::CreateTranslation(position);
-
-  // Normal matrix (for lighting, if needed)
-  Matrix4 normalMatrix = Matrix4::CreateFromQuaternion(rotation);
-
-  // Prepare instance data for a single mesh
-  std::vector<float> instanceData;
-  instanceData.reserve(36); // 36 floats per instance
+  mGPUTimer->Begin(GPUPass::Debug);
+}
 
-  // Add model matrix (16 floats)
-  for (int row = 0; row < 4; row++) {
-    for (int col = 0; col < 4; col++) {
-      instanceData.push_back(model.mat[row][col]);
-    }
-  }
+void Renderer::EndDebugDraw() {
+  mGPUTimer->End();
+  GLState::SetPolygonMode(GL_FILL);
+  glColorMaski(1, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
+}
 
-  // Add normal matrix (16 floats)
-  for (int row = 0; row < 4; row++) {
-    for (int col = 0; col < 4; col++) {
-      instanceData.push_back(normalMatrix.mat[row][col]);
-    }
+void Renderer::DrawSingleMesh(Mesh *mesh, const Vector3 &position,
+                              const Vector3 &scale,
+                              const Quaternion &rotation) {
+  if (!mesh || !mMeshShader) {
+    return;
   }
 
-  // Add green color (3 floats) for all debug colliders
-  instanceData.push_back(0.0f); // R
-  instanceData.push_back(1.0f); // G
-  instanceData.push_back(0.0f); // B
-
-  // Add tile index (1 float) - -1 means no texture
-  instanceData.push_back(-1.0f);
+  // Green for all debug colliders, not bloomed, no texture (tile -1)
+  MeshInstance instanceData;
+  PackInstance(instanceData, position, scale, rotation,
+               Vector3(0.0f, 1.0f, 0.0f), false, -1, 0);
 
-  // Update instance buffer with single instance
-  mesh->UpdateInstanceBuffer(instanceData, 1);
-
-  // Draw using instanced rendering with 1 instance
-  glDrawElementsInstanced(GL_TRIANGLES, mesh->GetNumIndices(), GL_UNSIGNED_INT,
-                          nullptr, 1);
-
-  // Restore polygon mode
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-  // Re-enable depth test
-  glEnable(GL_DEPTH_TEST);
+  // Stream the single instance and activate the mesh VAO with it
+  InstanceRange instance;
+  StreamInstances(&instanceData, 1, instance);
+  mesh->SetActive(instance);
+  DrawInstanced(mesh, 1);
 }
 
 void Renderer::CreateScreenQuad() {
@@ -1003,11 +1765,11 @@ void Renderer::CreateScreenQuad() {
 void Renderer::CreateFramebuffer() {
   // Generate framebuffer
   glGenFramebuffers(1, &mFramebuffer);
-  glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+  GLState::BindFramebuffer(mFramebuffer);
 
   // Create color texture
   glGenTextures(1, &mFramebufferTexture);
-  glBindTexture(GL_TEXTURE_2D, mFramebufferTexture);
+  GLState::BindTexture(0, mFramebufferTexture);
   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mFramebufferWidth, mFramebufferHeight,
                0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
@@ -1018,6 +1780,25 @@ void Renderer::CreateFramebuffer() {
   glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
                          mFramebufferTexture, 0);
 
+  // Create bloom color texture, the second target of the same pass. Bloomed
+  // objects write their color there and everything else writes black
+  // (occlusion)
+  glGenTextures(1, &mBloomTexture);
+  GLState::BindTexture(0, mBloomTexture);
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mFramebufferWidth, mFramebufferHeight,
+               0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                  GL_LINEAR); // Linear for smooth blur
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D,
+                         mBloomTexture, 0);
+
+  // Fragment outputs 0 and 1 go to the scene and bloom textures
+  const GLenum drawBuffers[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+  glDrawBuffers(2, drawBuffers);
+
   // Create depth and stencil renderbuffer
   glGenRenderbuffers(1, &mFramebufferDepthStencil);
   glBindRenderbuffer(GL_RENDERBUFFER, mFramebufferDepthStencil);
@@ -1032,7 +1813,7 @@ void Renderer::CreateFramebuffer() {
   }
 
   // Unbind framebuffer
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLState::BindFramebuffer(0);
 
   std::cout << "Framebuffer created: " << mFramebufferWidth << "x"
             << mFramebufferHeight << std::endl;
@@ -1040,13 +1821,13 @@ void Renderer::CreateFramebuffer() {
 
 void Renderer::BeginFramebuffer() {
   // Bind to framebuffer for rendering
-  glBindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+  GLState::BindFramebuffer(mFramebuffer);
   glViewport(0, 0, mFramebufferWidth, mFramebufferHeight);
 
   // Ensure depth test is enabled for 3D rendering
-  glEnable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
 
-  // Clear framebuffer with the background color
+  // Clear both targets with the background color
   if (mGame->IsDebugging()) {
     glClearColor(0.2f, 0.2f, 0.2f, 1.0f); // Dark gray for debugging
   } else {
@@ -1054,12 +1835,14 @@ void Renderer::BeginFramebuffer() {
                  1.0f);
   }
 
+  mGPUTimer->Begin(GPUPass::Clear);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  mGPUTimer->End();
 }
 
 void Renderer::EndFramebuffer() {
   // Unbind framebuffer (render to screen)
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLState::BindFramebuffer(0);
 
   // Get actual window size from SDL instead of viewport (which might be set to
   // framebuffer size)
@@ -1078,37 +1861,35 @@ void Renderer::EndFramebuffer() {
   // Set viewport to full window
   glViewport(0, 0, windowWidth, windowHeight);
 
+  mGPUTimer->Begin(GPUPass::Composite);
+
   // Clear screen to background color (only color buffer, preserve depth)
   glClearColor(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z,
                1.0f);
   glClear(GL_COLOR_BUFFER_BIT);
 
   // Disable depth test for screen quad
-  glDisable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, false);
 
   // Activate framebuffer shader
   mFramebufferShader->SetActive();
 
   // Bind framebuffer texture
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, mFramebufferTexture);
-  mFramebufferShader->SetIntegerUniform("uFramebufferTexture", 0);
+  GLState::BindTexture(0, mFramebufferTexture);
 
   mFramebufferShader->SetIntegerUniform("uIsDark",
                                         mGame->IsDebugging() ? 0 : mIsDark);
 
-  // Bind bloom texture (final blurred result is in mBlurTexture1 or
-  // mBlurTexture2 depending on odd/even passes)
-  glActiveTexture(GL_TEXTURE1);
-  glBindTexture(GL_TEXTURE_2D,
-                mBlurTexture1); // Final blur result is always in texture1 after
-                                // odd number of passes
-  mFramebufferShader->SetIntegerUniform("uBloomTexture", 1);
+  // Bind bloom texture (the blurred result is in the half resolution level,
+  // filtered up). Without bloomed objects the blur was skipped, the target
+  // still holds the background color dark scenes are lit by
+  GLState::BindTexture(1, mHasBloom ? mBloomMips[0].texture : mBloomTexture);
 
   // Draw fullscreen quad directly without transformation
   mScreenQuad->SetActive();
   glDrawElements(GL_TRIANGLES, mScreenQuad->GetNumIndices(), GL_UNSIGNED_INT,
                  nullptr);
+  mGPUTimer->End();
 
   // Debug: check for OpenGL errors
   GLenum err = glGetError();
@@ -1124,306 +1905,208 @@ void Renderer::EndFramebuffer() {
                1.0f);
 }
 
-void Renderer::DrawHUDSprites(
-    const std::vector<SpriteComponent *> &hudSprites) {
-  if (hudSprites.empty() || !mHUDShader || !mSpriteQuad) {
+void Renderer::DrawHUDSprites() {
+  mHUDDraws = 0;
+  if (mHUDLayers.empty() || !mHUDShader || !mSpriteQuad) {
     return;
   }
 
-  // Sort HUD sprites by Z position (draw order)
-  // Lower Z values are drawn first (background), higher Z values drawn last
-  // (foreground)
-  std::vector<SpriteComponent *> sortedHudSprites = hudSprites;
-  std::sort(sortedHudSprites.begin(), sortedHudSprites.end(),
-            [](const SpriteComponent *a, const SpriteComponent *b) {
-              return a->GetOwner()->GetPosition().z <
-                     b->GetOwner()->GetPosition().z;
-            });
+  int windowWidth, windowHeight;
+  SDL_GL_GetDrawableSize(SDL_GL_GetCurrentWindow(), &windowWidth,
+                         &windowHeight);
+  if (windowWidth <= 0 || windowHeight <= 0) {
+    return;
+  }
 
   // Ensure depth test is disabled (HUD always draws on top)
-  glDisable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, false);
 
   // Disable backface culling for HUD sprites (allows flipping)
-  glDisable(GL_CULL_FACE);
+  GLState::SetEnabled(GL_CULL_FACE, false);
+
+  mGPUTimer->Begin(GPUPass::HUD);
 
   // Activate HUD shader
   mHUDShader->SetActive();
 
-  // Group HUD sprites by texture atlas while maintaining draw order
-  struct HUDGroup {
-    TextureAtlas *atlas;
-    int textureIndex;
-    std::vector<SpriteComponent *> components;
-  };
-
-  std::vector<HUDGroup> groups;
-
-  // Group HUD sprites by atlas (already sorted by Z)
-  for (auto *spriteComp : sortedHudSprites) {
-    if (!spriteComp->IsVisible())
+  for (auto *layer : mHUDLayers) {
+    if (layer->instances.empty()) {
       continue;
-
-    TextureAtlas *atlas = spriteComp->GetTextureAtlas();
-    int texIndex = spriteComp->GetTextureIndex();
-
-    // Find or create group
-    bool found = false;
-    for (auto &group : groups) {
-      if (group.atlas == atlas && group.textureIndex == texIndex) {
-        group.components.push_back(spriteComp);
-        found = true;
-        break;
-      }
-    }
-
-    if (!found) {
-      groups.push_back({atlas, texIndex, {spriteComp}});
     }
-  }
 
-  // Draw each HUD sprite group
-  for (auto &group : groups) {
-    if (group.components.empty())
-      continue;
+    if (layer->dirty) {
+      if ((layer->textureWidth != windowWidth ||
+           layer->textureHeight != windowHeight) &&
+          !ResizeHUDLayer(layer, windowWidth, windowHeight)) {
+        // Laid out again next frame, to retry
+        layer->width = 0;
+        continue;
+      }
+      GLState::BindFramebuffer(layer->framebuffer);
+      glViewport(0, 0, windowWidth, windowHeight);
+      glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      // The layer holds premultiplied color and the coverage of everything
+      // drawn into it, so compositing it matches drawing the sprites over
+      // the scene
+      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE,
+                          GL_ONE_MINUS_SRC_ALPHA);
+
+      // One instanced draw per run, the runs are in draw order
+      for (const auto &run : layer->runs) {
+        bool hasTexture = run.textureIndex >= 0 &&
+                          run.textureIndex < static_cast<int>(mTextures.size());
+        if (hasTexture) {
+          mTextures[run.textureIndex]->Bind(0);
+        }
+        if (hasTexture && run.atlas) {
+          mHUDShader->SetIntegerUniform("uAtlasColumns",
+                                        run.atlas->GetColumns());
+          mHUDShader->SetVectorUniform("uAtlasTileSize",
+                                       Vector2(run.atlas->GetUVTileSizeX(),
+                                               run.atlas->GetUVTileSizeY()));
+        }
+        mHUDShader->SetIntegerUniform("uHasTexture",
+                                      run.textureIndex == -1 ? 0 : 1);
+
+        mSpriteQuad->SetActiveHUD(
+            InstanceRange{layer->range.buffer,
+                          layer->range.offset +
+                              run.first * sizeof(HUDInstance)});
+        DrawInstanced(mSpriteQuad, run.count);
+        mHUDDraws++;
+      }
 
-    // Bind texture atlas or single texture
-    if (group.atlas && group.textureIndex >= 0 &&
-        group.textureIndex < static_cast<int>(mTextures.size())) {
-      mTextures[group.textureIndex]->Bind(0);
-      mHUDShader->SetIntegerUniform("uHUDTexture", 0);
-      mHUDShader->SetIntegerUniform("uAtlasColumns", group.atlas->GetColumns());
-      mHUDShader->SetVectorUniform("uAtlasTileSize",
-                                   Vector2(group.atlas->GetUVTileSizeX(),
-                                           group.atlas->GetUVTileSizeY()));
-    } else if (!group.atlas && group.textureIndex >= 0 &&
-               group.textureIndex < static_cast<int>(mTextures.size())) {
-      // Bind single texture (no atlas)
-      mTextures[group.textureIndex]->Bind(0);
-      mHUDShader->SetIntegerUniform("uHUDTexture", 0);
-      // No atlas uniforms needed
-    }
+      layer->dirty = false;
+      mHUDRedraws++;
 
-    if (group.textureIndex == -1) {
-      // No texture bound
-      mHUDShader->SetIntegerUniform("uHasTexture", 0);
-    } else {
-      mHUDShader->SetIntegerUniform("uHasTexture", 1);
+      GLState::BindFramebuffer(0);
+      glViewport(0, 0, windowWidth, windowHeight);
+      glClearColor(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z,
+                   1.0f);
     }
 
-    // Draw each HUD sprite individually
-    // (Using simple non-instanced drawing for HUD simplicity)
-    for (auto *spriteComp : group.components) {
-      // Get sprite properties
-      Vector3 screenPos =
-          spriteComp->GetOwner()->GetPosition() + spriteComp->GetOffset();
-      Vector3 scale =
-          spriteComp->GetOwner()->GetScale() * spriteComp->GetScale();
-      Vector3 color = spriteComp->GetColor();
-      int tileIndex = spriteComp->GetTextureAtlas()
-                          ? spriteComp->GetCurrentTileIndex()
-                          : -1;
-
-      // Position is already in normalized screen coordinates
-      // X: -1 (left) to 1 (right), 0 = center
-      // Y: -1 (bottom) to 1 (top), 0 = center
-      // Z: used for draw order (not position)
-      float ndcX = screenPos.x;
-      float ndcY = screenPos.y;
-
-      // Scale is also in normalized coordinates
-      // 1.0 = full screen width/height
-      // 0.1 = 10% of screen
-      float ndcScaleX = scale.x;
-      float ndcScaleY = scale.y;
-
-      // Set uniforms for this HUD sprite
-      mHUDShader->SetVectorUniform("uNDCPosition", Vector2(ndcX, ndcY));
-      mHUDShader->SetVectorUniform("uNDCScale", Vector2(ndcScaleX, ndcScaleY));
-      mHUDShader->SetIntegerUniform("uTileIndex", tileIndex);
-      mHUDShader->SetVectorUniform("uTintColor",
-                                   Vector4(color.x, color.y, color.z, 1.0f));
-
-      // Draw the sprite quad
-      mSpriteQuad->SetActive();
-      glDrawElements(GL_TRIANGLES, mSpriteQuad->GetNumIndices(),
-                     GL_UNSIGNED_INT, nullptr);
-    }
+    // Composite the layer's texture (its color is premultiplied)
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::BindTexture(0, layer->texture);
+    mHUDShader->SetIntegerUniform("uHasTexture", 1);
+    mSpriteQuad->SetActiveHUD(mHUDCompositeRange);
+    DrawInstanced(mSpriteQuad, 1);
   }
+  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  mGPUTimer->End();
 
   // Re-enable backface culling
-  glEnable(GL_CULL_FACE);
+  GLState::SetEnabled(GL_CULL_FACE, true);
 
   // Re-enable depth test
-  glEnable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
 }
 
-void Renderer::CreateBloomFramebuffer() {
-  // Generate bloom framebuffer
-  glGenFramebuffers(1, &mBloomFramebuffer);
-  glBindFramebuffer(GL_FRAMEBUFFER, mBloomFramebuffer);
-
-  // Create bloom color texture (same size as main framebuffer)
-  glGenTextures(1, &mBloomTexture);
-  glBindTexture(GL_TEXTURE_2D, mBloomTexture);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mFramebufferWidth, mFramebufferHeight,
-               0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
-                  GL_LINEAR); // Linear for smooth blur
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         mBloomTexture, 0);
-
-  // Create depth and stencil renderbuffer (same as main framebuffer)
-  glGenRenderbuffers(1, &mBloomDepthStencil);
-  glBindRenderbuffer(GL_RENDERBUFFER, mBloomDepthStencil);
-  glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, mFramebufferWidth,
-                        mFramebufferHeight);
-  glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
-                            GL_RENDERBUFFER, mBloomDepthStencil);
-
-  // Check if framebuffer is complete
-  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-    std::cerr << "ERROR: Bloom framebuffer is not complete!" << std::endl;
+void Renderer::CreateBloomMips() {
+  int width = mFramebufferWidth;
+  int height = mFramebufferHeight;
+
+  for (int i = 0; i < mBloomLevels && width > 1 && height > 1; i++) {
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+
+    BloomMip mip{0, 0, width, height};
+    glGenTextures(1, &mip.texture);
+    GLState::BindTexture(0, mip.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB,
+                 GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenFramebuffers(1, &mip.framebuffer);
+    GLState::BindFramebuffer(mip.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           mip.texture, 0);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+      std::cerr << "ERROR: Bloom framebuffer " << i << " is not complete!"
+                << std::endl;
+    }
+    mBloomMips.push_back(mip);
   }
 
   // Unbind framebuffer
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLState::BindFramebuffer(0);
 
-  std::cout << "Bloom framebuffer created: " << mFramebufferWidth << "x"
-            << mFramebufferHeight << std::endl;
+  std::cout << "Bloom chain created: " << mBloomMips.size()
+            << " levels, down to " << width << "x" << height << std::endl;
 }
 
-void Renderer::CreateBlurTextures() {
-  // Create two textures for ping-pong blur
-  glGenTextures(1, &mBlurTexture1);
-  glBindTexture(GL_TEXTURE_2D, mBlurTexture1);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mFramebufferWidth, mFramebufferHeight,
-               0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-  glGenTextures(1, &mBlurTexture2);
-  glBindTexture(GL_TEXTURE_2D, mBlurTexture2);
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, mFramebufferWidth, mFramebufferHeight,
-               0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-  // Create framebuffers for the blur textures
-  glGenFramebuffers(1, &mBlurFramebuffer1);
-  glBindFramebuffer(GL_FRAMEBUFFER, mBlurFramebuffer1);
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         mBlurTexture1, 0);
-
-  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-    std::cerr << "ERROR: Blur framebuffer 1 is not complete!" << std::endl;
+void Renderer::DestroyBloomMips() {
+  for (auto &mip : mBloomMips) {
+    glDeleteFramebuffers(1, &mip.framebuffer);
+    glDeleteTextures(1, &mip.texture);
   }
-
-  glGenFramebuffers(1, &mBlurFramebuffer2);
-  glBindFramebuffer(GL_FRAMEBUFFER, mBlurFramebuffer2);
-  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
-                         mBlurTexture2, 0);
-
-  if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
-    std::cerr << "ERROR: Blur framebuffer 2 is not complete!" << std::endl;
-  }
-
-  // Unbind framebuffer
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
-
-  std::cout << "Blur textures created: " << mFramebufferWidth << "x"
-            << mFramebufferHeight << std::endl;
+  mBloomMips.clear();
+  GLState::Invalidate();
 }
 
-void Renderer::BeginBloomPass() {
-  // Bind to bloom framebuffer for rendering
-  glBindFramebuffer(GL_FRAMEBUFFER, mBloomFramebuffer);
-  glViewport(0, 0, mFramebufferWidth, mFramebufferHeight);
-
-  // Ensure depth test is enabled for 3D rendering
-  glEnable(GL_DEPTH_TEST);
-
-  if (mGame->IsDebugging()) {
-    // Clear bloom framebuffer to dark gray in debugging mode
-    glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-  } else {
-    // Clear bloom framebuffer to black for proper bloom effect
-    // Clear bloom framebuffer to background color
-    glClearColor(mBackgroundColor.x, mBackgroundColor.y, mBackgroundColor.z,
-                 1.0f);
+void Renderer::SetBloomLevels(int levels) {
+  levels = std::max(1, levels);
+  if (levels == mBloomLevels) {
+    return;
   }
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
+  mBloomLevels = levels;
 
-void Renderer::EndBloomPass() {
-  // Nothing special needed here - just unbind will happen in EndFramebuffer
-  // We keep the bloom framebuffer active until we're ready to blur
+  // Rebuild the chain if it already exists
+  if (!mBloomMips.empty()) {
+    DestroyBloomMips();
+    CreateBloomMips();
+  }
 }
 
 void Renderer::ApplyBloomBlur() {
-  if (!mBloomBlurShader || !mScreenQuad) {
+  if (!mBloomDownShader || !mBloomUpShader || !mScreenQuad || !mHasBloom ||
+      mBloomMips.empty()) {
     return;
   }
 
+  mGPUTimer->Begin(GPUPass::BloomBlur);
+
   // Disable depth test for fullscreen blur passes
-  glDisable(GL_DEPTH_TEST);
-
-  // Activate blur shader
-  mBloomBlurShader->SetActive();
-
-  // Set Gaussian blur weights (5-tap)
-  // These weights should sum to 1.0
-  float weights[5] = {0.227027f, 0.1945946f, 0.1216216f, 0.054054f, 0.016216f};
-  mBloomBlurShader->SetFloatUniform("uWeights[0]", weights[0]);
-  mBloomBlurShader->SetFloatUniform("uWeights[1]", weights[1]);
-  mBloomBlurShader->SetFloatUniform("uWeights[2]", weights[2]);
-  mBloomBlurShader->SetFloatUniform("uWeights[3]", weights[3]);
-  mBloomBlurShader->SetFloatUniform("uWeights[4]", weights[4]);
-
-  // Perform multiple blur passes (ping-pong between textures)
-  // More passes = smoother blur, especially with large radius
-  int blurPasses = 10; // Increased from 5 to 10 for smoother wide bloom
-  bool horizontal = true;
-
-  for (int i = 0; i < blurPasses; ++i) {
-    // Bind appropriate framebuffer for output
-    glBindFramebuffer(GL_FRAMEBUFFER,
-                      horizontal ? mBlurFramebuffer1 : mBlurFramebuffer2);
-    glViewport(0, 0, mFramebufferWidth, mFramebufferHeight);
-
-    // Set horizontal/vertical uniform
-    mBloomBlurShader->SetIntegerUniform("uHorizontal", horizontal ? 1 : 0);
-
-    // Bind input texture (first pass uses bloom texture, subsequent passes use
-    // previous output)
-    glActiveTexture(GL_TEXTURE0);
-    if (i == 0) {
-      glBindTexture(GL_TEXTURE_2D, mBloomTexture);
-    } else {
-      glBindTexture(GL_TEXTURE_2D, horizontal ? mBlurTexture2 : mBlurTexture1);
-    }
-    mBloomBlurShader->SetIntegerUniform("uTexture", 0);
+  GLState::SetEnabled(GL_DEPTH_TEST, false);
+
+  mScreenQuad->SetActive();
 
-    // Draw fullscreen quad
-    mScreenQuad->SetActive();
+  // Downsample the bloom target through the chain (1/2, 1/4, ...), each pass
+  // filtering the level above
+  mBloomDownShader->SetActive();
+  GLuint source = mBloomTexture;
+  for (auto &mip : mBloomMips) {
+    GLState::BindFramebuffer(mip.framebuffer);
+    glViewport(0, 0, mip.width, mip.height);
+    GLState::BindTexture(0, source);
     glDrawElements(GL_TRIANGLES, mScreenQuad->GetNumIndices(), GL_UNSIGNED_INT,
                    nullptr);
+    source = mip.texture;
+  }
 
-    // Switch direction for next pass
-    horizontal = !horizontal;
+  // Upsample back to half resolution, blurring again on the way up
+  mBloomUpShader->SetActive();
+  for (int i = static_cast<int>(mBloomMips.size()) - 2; i >= 0; i--) {
+    GLState::BindFramebuffer(mBloomMips[i].framebuffer);
+    glViewport(0, 0, mBloomMips[i].width, mBloomMips[i].height);
+    GLState::BindTexture(0, mBloomMips[i + 1].texture);
+    glDrawElements(GL_TRIANGLES, mScreenQuad->GetNumIndices(), GL_UNSIGNED_INT,
+                   nullptr);
   }
 
+  mGPUTimer->End();
+
   // Unbind framebuffer
-  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  GLState::BindFramebuffer(0);
 
   // Re-enable depth test
-  glEnable(GL_DEPTH_TEST);
+  GLState::SetEnabled(GL_DEPTH_TEST, true);
 }
 
 void Renderer::AddUIElement(HUDElement *comp) {
@@ -1,6 +1,7 @@
 #include <GL/glew.h>
 #include <iostream>
 #include "render/Shader.hpp"
+#include "render/GLState.hpp"
 #include <fstream>
 #include <sstream>
 
@@ -51,6 +52,7 @@ void Shader::Unload()
 {
 	// Delete the program/shaders
 	glDeleteProgram(mShaderProgram);
+	GLState::Invalidate();
 	glDeleteShader(mVertexShader);
 	glDeleteShader(mFragShader);
 
@@ -62,13 +64,13 @@ void Shader::Unload()
 void Shader::SetActive() const
 {
 	// Set this program as the active one
-	glUseProgram(mShaderProgram);
+	GLState::UseProgram(mShaderProgram);
 }
 
 void Shader::SetVectorUniform(const char *name, const Vector2 &vector) const
 {
 	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+	GLint loc = GetUniformLocation(name);
 
 	// Send the vector data to the uniform
 	glUniform2fv(loc, 1, vector.GetAsFloatPtr());
@@ -77,7 +79,7 @@ void Shader::SetVectorUniform(const char *name, const Vector2 &vector) const
 void Shader::SetVectorUniform(const char *name, const Vector3 &vector) const
 {
 	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+	GLint loc = GetUniformLocation(name);
 
 	// Send the vector data to the uniform
 	glUniform3fv(loc, 1, vector.GetAsFloatPtr());
@@ -86,7 +88,7 @@ void Shader::SetVectorUniform(const char *name, const Vector3 &vector) const
 void Shader::SetVectorUniform(const char *name, const Vector4 &vector) const
 {
 	// Find the uniform by this name
-	GLint loc = glGetUniformLocation(mShaderProgram, name);
+	GLint loc = GetUniformLocation(name);
 
 	// Send the vector data to the uniform
 	glUniform4fv(loc, 1, vector.GetAsFloatPtr());
@@ -95,7 +97,7 @@ void Shader::SetVectorUniform(const char *name, const Vector4 &vector) const
 void Shader::SetMatrixUniform(const char *name, const Matrix4 &matrix) const
 {
 	// Find the uniform by this name
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+	GLint loc = GetUniformLocation(name);
 
 	// Send the matrix data to the uniform
 	glUniformMatrix4fv(loc, 1, GL_FALSE, matrix.GetAsFloatPtr());
@@ -104,7 +106,7 @@ void Shader::SetMatrixUniform(const char *name, const Matrix4 &matrix) const
 void Shader::SetFloatUniform(const char *name, float value) const
 {
 	// Find the uniform by this name
-	GLuint loc = glGetUniformLocation(mShaderProgram, name);
+	GLint loc = GetUniformLocation(name);
 
 	// Send the float data to the uniform
 	glUniform1f(loc, value);
@@ -112,8 +114,8 @@ void Shader::SetFloatUniform(const char *name, float value) const
 
 void Shader::SetIntegerUniform(const char *name, int value) const
 {
-	GLint uTexture = glGetUniformLocation(mShaderProgram, name);
-	glUniform1i(uTexture, value);
+	GLint loc = GetUniformLocation(name);
+	glUniform1i(loc, value);
 }
 
 bool Shader::CompileShader(const std::string &fileName, GLenum shaderType, GLuint &outShader)
@@ -206,8 +208,20 @@ void Shader::GatherUniforms()
 
 		glGetActiveUniform(mShaderProgram, i, sizeof(uniformName), &length, &size, &type, uniformName);
 
-		// Store the uniform name
-		mUniforms.insert(std::string(uniformName));
+		// Store the uniform name and location
+		std::string name(uniformName, length);
+		mUniforms[name] = glGetUniformLocation(mShaderProgram, uniformName);
+
+		// Arrays are reported as "name[0]", each element has its own location
+		if (size > 1 && name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+		{
+			std::string base = name.substr(0, name.size() - 3);
+			for (GLint element = 1; element < size; element++)
+			{
+				std::string elementName = base + "[" + std::to_string(element) + "]";
+				mUniforms[elementName] = glGetUniformLocation(mShaderProgram, elementName.c_str());
+			}
+		}
 	}
 }
 
@@ -215,3 +229,9 @@ bool Shader::HasUniform(const std::string &name) const
 {
 	return mUniforms.find(name) != mUniforms.end();
 }
+
+GLint Shader::GetUniformLocation(const char *name) const
+{
+	auto iter = mUniforms.find(name);
+	return iter != mUniforms.end() ? iter->second : -1;
+}
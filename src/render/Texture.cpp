@@ -1,4 +1,5 @@
 #include "render/Texture.hpp"
+#include "render/GLState.hpp"
 #include <SDL2/SDL_image.h>
 #include <iostream>
 
@@ -38,7 +39,7 @@ bool Texture::Load(const std::string &fileName) {
 
   // Generate and bind texture
   glGenTextures(1, &mTextureID);
-  glBindTexture(GL_TEXTURE_2D, mTextureID);
+  GLState::BindTexture(0, mTextureID);
 
   // Upload texture data
   glTexImage2D(GL_TEXTURE_2D, 0, format, mWidth, mHeight, 0, format,
@@ -85,7 +86,7 @@ bool Texture::LoadFromSurface(SDL_Surface *surface) {
 
   // Generate and bind texture
   glGenTextures(1, &mTextureID);
-  glBindTexture(GL_TEXTURE_2D, mTextureID);
+  GLState::BindTexture(0, mTextureID);
 
   // Upload texture data (always RGBA now)
   glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA,
@@ -109,12 +110,12 @@ void Texture::Unload() {
   if (mTextureID != 0) {
     glDeleteTextures(1, &mTextureID);
     mTextureID = 0;
+    GLState::Invalidate();
   }
 }
 
 void Texture::Bind(unsigned int textureUnit) {
-  glActiveTexture(GL_TEXTURE0 + textureUnit);
-  glBindTexture(GL_TEXTURE_2D, mTextureID);
+  GLState::BindTexture(textureUnit, mTextureID);
 }
 
-void Texture::Unbind() { glBindTexture(GL_TEXTURE_2D, 0); }
+void Texture::Unbind() { GLState::BindTexture(0, 0); }
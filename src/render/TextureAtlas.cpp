@@ -108,6 +108,16 @@ bool TextureAtlas::Load(const std::string& jsonPath)
     return true;
 }
 
+void TextureAtlas::SetGrid(int atlasWidth, int atlasHeight, int tileWidth, int tileHeight)
+{
+    mAtlasWidth = atlasWidth;
+    mAtlasHeight = atlasHeight;
+    mTileWidth = tileWidth;
+    mTileHeight = tileHeight;
+    mColumns = atlasWidth / tileWidth;
+    mRows = atlasHeight / tileHeight;
+}
+
 int TextureAtlas::GetTileIndex(const std::string& tileName) const
 {
     auto it = mTiles.find(tileName);
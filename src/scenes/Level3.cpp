@@ -39,6 +39,7 @@ void Level3::LoadLevel(const std::string &levelPath) {
   int enemyCounter = 1, noteCounter = 1;
 
   MapReader mapReader(levelPath + "_terrain.csv");
+  GroundTilemap &tilemap = ResetGround(mapReader.width, mapReader.height);
 
   for (const auto actor : mapReader.GetMapActors()) {
 
@@ -77,236 +78,167 @@ void Level3::LoadLevel(const std::string &levelPath) {
       break;
     }
     case 129: {
-      auto ground = new GroundActor(mGame, Color::White, 24);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 24);
       break;
     }
     case 104: {
-      auto ground = new GroundActor(mGame, Color::White, 2);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 2);
       break;
     }
     case 132: {
-      auto hole = new MagicWater(mGame);
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::MagicWater, 51);
+      auto hole = new Hole(mGame);
       hole->SetPosition(Vector3(x, 0.0f, z));
       hole->SetScale(Vector3(size_x, 1.0f, size_y));
       break;
     }
     case 107: {
-      auto ground = new GroundActor(mGame, Color::White, 10);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 10);
       break;
     }
     case 110: {
-      auto ground = new GroundActor(mGame, Color::White, 25);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 25);
       break;
     }
     case 88: {
-      auto ground = new GroundActor(mGame, Color::White, 57);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 57);
       break;
     }
     case 95: {
-      auto ground = new GroundActor(mGame, Color::White, 27);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 27);
       break;
     }
     case 130: {
-      auto ground = new GroundActor(mGame, Color::White, 15);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 15);
       break;
     }
     case 113: {
-      auto ground = new GroundActor(mGame, Color::White, 40);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 40);
       break;
     }
 
     case 119: {
-      auto ground = new GroundActor(mGame, Color::White, 48);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 48);
       break;
     }
     case 101: {
-      auto ground = new GroundActor(mGame, Color::White, 64);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 64);
       break;
     }
     case 103: {
-      auto ground = new GroundActor(mGame, Color::White, 9);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 9);
       break;
     }
     case 128: {
-      auto ground = new GroundActor(mGame, Color::White, 3);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 3);
       break;
     }
     case 111: {
-      auto ground = new GroundActor(mGame, Color::White, 18);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 18);
       break;
     }
     case 114: {
-      auto ground = new GroundActor(mGame, Color::White, 33);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 33);
       break;
     }
     case 117: {
-      auto ground = new GroundActor(mGame, Color::White, 12);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 12);
       break;
     }
 
     case 122: {
-      auto ground = new GroundActor(mGame, Color::White, 20);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 20);
       break;
     }
 
     case 125: {
-      auto ground = new GroundActor(mGame, Color::White, 56);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 56);
       break;
     }
 
     case 127: {
-      auto ground = new GroundActor(mGame, Color::White, 42);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 42);
       break;
     }
 
     case 98: {
-      auto ground = new GroundActor(mGame, Color::White, 21);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 21);
       break;
     }
 
     case 99: {
-      auto ground = new GroundActor(mGame, Color::White, 14);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 14);
       break;
     }
 
     case 100: {
-      auto ground = new GroundActor(mGame, Color::White, 7);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 7);
       break;
     }
 
     case 89: {
-      auto ground = new GroundActor(mGame, Color::White, 0);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 0);
       break;
     }
 
     case 120: {
-      auto ground = new GroundActor(mGame, Color::White, 41);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 41);
       break;
     }
 
     case 109: {
-      auto ground = new GroundActor(mGame, Color::White, 32);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 32);
       break;
     }
 
     case 123: {
-      auto ground = new GroundActor(mGame, Color::White, 13);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 13);
       break;
     }
 
     case 126: {
-      auto ground = new GroundActor(mGame, Color::White, 49);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 49);
       break;
     }
     case 112: {
-      auto ground = new GroundActor(mGame, Color::White, 4);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 4);
       break;
     }
     case 115: {
-      auto ground = new GroundActor(mGame, Color::White, 26);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 26);
       break;
     }
 
     case 131: {
-      auto ground = new GroundActor(mGame, Color::White, 11);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 11);
       break;
     }
 
     case 92: {
-      auto ground = new GroundActor(mGame, Color::White, 8);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 8);
       break;
     }
 
     case 97: {
-      auto ground = new GroundActor(mGame, Color::White, 28);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 28);
       break;
     }
 
     case 106: {
-      auto ground = new GroundActor(mGame, Color::White, 17);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 17);
       break;
     }
 
     case 118: {
-      auto ground = new GroundActor(mGame, Color::White, 5);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 5);
       break;
     }
     case 121: {
-      auto ground = new GroundActor(mGame, Color::White, 34);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 34);
       break;
     }
     case 124: {
-      auto ground = new GroundActor(mGame, Color::White, 6);
-      ground->SetPosition(Vector3(x, 0.0f, z));
-      ground->SetScale(Vector3(size_x, 1.0f, size_y));
+      tilemap.Fill(x, z, size_x, size_y, GroundKind::Ground, 6);
       break;
     }
 
@@ -10,9 +10,21 @@
 #include "actors/EnemyGroup.hpp"
 #include "actors/Ghost.hpp"
 #include "render/Renderer.hpp"
+#include "render/TextureAtlas.hpp"
 #include "actors/PuzzleActors.hpp"
 #include "actors/SceneActors.hpp"
 
+void Scene::SetDefaultCollisionMasks() {
+  // Notes pass over holes
+  for (auto mask : {&mExplorationMask, &mBattleMask}) {
+    mask->Set(ColliderLayer::Hole, ColliderLayer::Note, false);
+  }
+
+  // In battle combatants no longer push each other, and triggers and items
+  // only react to the player
+  mBattleMask.Set(ColliderLayer::Entity, ColliderLayer::Entity, false);
+}
+
 void Scene::Cleanup() {
   // Remove all HUD elements from renderer
   auto renderer = mGame->GetRenderer();
@@ -24,6 +36,9 @@ void Scene::Cleanup() {
         renderer->RemoveUIElement(hud);
       }
     }
+
+    // The next scene starts without a floor
+    renderer->GetGroundTilemap().Clear();
   }
 
   // Iterate over a copy since deletion modifies the set
@@ -80,6 +95,23 @@ int Scene::GetEnemyBitmask(int encounterNumber) {
   return sortedCombinations[encounterNumber];
 }
 
+GroundTilemap &Scene::ResetGround(unsigned columns, unsigned rows) {
+  Renderer *renderer = mGame->GetRenderer();
+  std::string levelPath = mGame->GetLevelAssetPath();
+  Texture *texture = renderer->LoadTexture(levelPath + "floor.png");
+  TextureAtlas *atlas = renderer->LoadAtlas(levelPath + "floor.json");
+  atlas->SetTextureIndex(renderer->GetTextureIndex(texture));
+
+  GroundTilemap &ground = renderer->GetGroundTilemap();
+  ground.Reset(static_cast<int>(columns), static_cast<int>(rows), atlas);
+  if (mSceneID == SceneEnum::scene2) {
+    GroundMaterial material = ground.GetMaterial(GroundKind::Ground);
+    material.bloomed = true;
+    ground.SetMaterial(GroundKind::Ground, material);
+  }
+  return ground;
+}
+
 void Scene::LoadLevel(const std::string &levelPath) {
   // Empty default implementation - should be overridden by subclasses
 }